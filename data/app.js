@@ -1,7 +1,13 @@
 // CYD World Clock - Web UI JavaScript
 
-// Global timezone list
-let timezones = [];
+// Timezones the page has seen (search results, configured cities) by
+// catalog id; the catalog itself stays on the device
+const timezones = new Map();
+
+// Remote city rows in the form (5 are in index.html, the rest are added here)
+const MIN_REMOTE_CITIES = 5;
+let maxRemoteCities = 24;
+let remoteCityCount = MIN_REMOTE_CITIES;
 
 // Load state on page load
 document.addEventListener('DOMContentLoaded', async () => {
@@ -18,17 +24,16 @@ document.addEventListener('DOMContentLoaded', async () => {
   document.getElementById('screenFlipInterval').addEventListener('change', handleFlipIntervalChange);
   document.getElementById('snapshotBtn').addEventListener('click', handleSnapshot);
 
-  // Timezone dropdown change listeners
-  document.getElementById('homeSelect').addEventListener('change', updateTimezoneFields);
-  document.getElementById('remote0Select').addEventListener('change', updateTimezoneFields);
-  document.getElementById('remote1Select').addEventListener('change', updateTimezoneFields);
-  document.getElementById('remote2Select').addEventListener('change', updateTimezoneFields);
-  document.getElementById('remote3Select').addEventListener('change', updateTimezoneFields);
-  document.getElementById('remote4Select').addEventListener('change', updateTimezoneFields);
-
-  // Load timezones FIRST, then load state (must be in order)
-  // This prevents race condition where loadState runs before dropdowns are populated
-  await loadTimezones();
+  // Timezone dropdown change listeners (extra cities register their own)
+  timezoneSelectIds().forEach(id => {
+    document.getElementById(id).addEventListener('change', updateTimezoneFields);
+  });
+  document.getElementById('addCityBtn').addEventListener('click', () => setRemoteCityCount(remoteCityCount + 1));
+  document.getElementById('removeCityBtn').addEventListener('click', () => setRemoteCityCount(remoteCityCount - 1));
+
+  // City selectors start empty: search fills them, loadState() adds the
+  // configured zones
+  timezoneSelectIds().forEach(initTimezoneSelector);
   await loadState();
 
   // Start polling AFTER initial load is complete
@@ -52,71 +57,151 @@ function startPolling() {
   tick();
 }
 
-// Load timezone list from device
-async function loadTimezones() {
-  try {
-    const response = await fetch('/api/timezones');
-    if (!response.ok) throw new Error('Failed to fetch timezones');
-
-    timezones = await response.json();
-    console.log(`Loaded ${timezones.length} timezones`);
-
-    // Populate all dropdowns
-    populateTimezoneDropdown('homeSelect');
-    populateTimezoneDropdown('remote0Select');
-    populateTimezoneDropdown('remote1Select');
-    populateTimezoneDropdown('remote2Select');
-    populateTimezoneDropdown('remote3Select');
-    populateTimezoneDropdown('remote4Select');
-  } catch (error) {
-    console.error('Error loading timezones:', error);
-    showNotification('Error loading timezone list', 'error');
+// Matches per search request (one small device response)
+const TZ_SEARCH_LIMIT = 10;
+
+function timezoneSelectIds() {
+  const ids = ['homeSelect'];
+  for (let i = 0; i < remoteCityCount; i++) ids.push(`remote${i}Select`);
+  return ids;
+}
+
+// Search the device's timezone catalog by name (prefix matches first)
+async function searchTimezones(q, limit = TZ_SEARCH_LIMIT) {
+  const response = await fetch(`/api/timezones?q=${encodeURIComponent(q)}&limit=${limit}`);
+  if (!response.ok) throw new Error('Timezone search failed');
+
+  const results = await response.json();
+  results.forEach(tz => timezones.set(String(tz.id), tz));
+  return results;
+}
+
+// City dropdown with a search box above it, listing nothing until searched
+function initTimezoneSelector(selectId) {
+  setTimezoneOptions(selectId, []);
+  addTimezoneSearch(selectId);
+}
+
+// Add form rows for remote cities 6+ (or remove them) to match count
+function setRemoteCityCount(count) {
+  count = Math.max(MIN_REMOTE_CITIES, Math.min(maxRemoteCities, count));
+  const container = document.getElementById('extraCities');
+
+  while (remoteCityCount < count) {
+    const i = remoteCityCount;
+    const group = document.createElement('div');
+    group.className = 'city-group';
+    group.id = `remote${i}Group`;
+    group.innerHTML = `
+      <label>City ${i + 1}:</label>
+      <select id="remote${i}Select" name="remote${i}Select" required></select>
+      <div id="remote${i}Custom" style="display: none; margin-top: 5px;">
+        <input type="text" id="remote${i}CustomLabel" placeholder="City name" style="width: 48%; margin-right: 4%;">
+        <input type="text" id="remote${i}CustomTz" placeholder="TZ string" style="width: 48%; font-family: monospace;">
+      </div>
+      <input type="hidden" id="remote${i}Label" name="remote${i}Label">
+      <input type="hidden" id="remote${i}Tz" name="remote${i}Tz">
+      <small id="remote${i}TzDisplay" style="color: #00d9ff; font-family: monospace;"></small>`;
+    container.appendChild(group);
+
+    const select = document.getElementById(`remote${i}Select`);
+    select.addEventListener('change', updateTimezoneFields);
+    remoteCityCount++;
+    initTimezoneSelector(select.id);
+  }
+
+  while (remoteCityCount > count) {
+    remoteCityCount--;
+    document.getElementById(`remote${remoteCityCount}Group`).remove();
   }
+
+  document.getElementById('remoteCount').textContent = remoteCityCount;
 }
 
-// Populate a specific dropdown with timezone options grouped by region
-function populateTimezoneDropdown(selectId) {
+// Search box above a city dropdown: matches come from the device's name
+// index (prefix matches first) as suggestions and as the dropdown's options;
+// picking a suggestion selects it
+function addTimezoneSearch(selectId) {
+  if (document.getElementById(selectId + 'Search')) return;
   const select = document.getElementById(selectId);
-  select.innerHTML = '<option value="">-- Select a city --</option>';
 
-  // Define region ranges based on timezones.h structure
-  const regions = [
-    { name: 'Australia & Oceania', start: 0, end: 11 },
-    { name: 'North America', start: 12, end: 28 },
-    { name: 'South America', start: 29, end: 34 },
-    { name: 'Western Europe', start: 35, end: 45 },
-    { name: 'Northern Europe', start: 46, end: 49 },
-    { name: 'Central & Eastern Europe', start: 50, end: 57 },
-    { name: 'Middle East', start: 58, end: 62 },
-    { name: 'South Asia', start: 63, end: 69 },
-    { name: 'Southeast Asia', start: 70, end: 76 },
-    { name: 'East Asia', start: 77, end: 82 },
-    { name: 'Central Asia', start: 83, end: 85 },
-    { name: 'Caucasus', start: 86, end: 88 },
-    { name: 'Africa', start: 89, end: 101 }
-  ];
-
-  regions.forEach(region => {
-    const optgroup = document.createElement('optgroup');
-    optgroup.label = region.name;
-
-    for (let i = region.start; i <= region.end && i < timezones.length; i++) {
-      const tz = timezones[i];
-      const option = document.createElement('option');
-      option.value = i;
-      option.textContent = tz.name;
-      option.dataset.tz = tz.tz;
-      optgroup.appendChild(option);
+  const input = document.createElement('input');
+  input.type = 'search';
+  input.id = selectId + 'Search';
+  input.className = 'tz-search';
+  input.placeholder = 'Search cities (e.g. syd)';
+  input.setAttribute('list', selectId + 'Matches');
+
+  const matches = document.createElement('datalist');
+  matches.id = selectId + 'Matches';
+
+  select.parentNode.insertBefore(input, select);
+  select.parentNode.insertBefore(matches, select);
+
+  let searchTimer = null;
+  input.addEventListener('input', () => {
+    // A suggestion was picked: select it
+    const picked = [...timezones.values()].find(t => t.name === input.value);
+    if (picked) {
+      selectTimezone(selectId, picked);
+      select.dispatchEvent(new Event('change'));
+      return;
     }
 
-    select.appendChild(optgroup);
+    clearTimeout(searchTimer);
+    searchTimer = setTimeout(async () => {
+      const q = input.value.trim();
+      matches.innerHTML = '';
+      if (!q) return;
+      try {
+        const results = await searchTimezones(q);
+        results.forEach(tz => {
+          const option = document.createElement('option');
+          option.value = tz.name;
+          matches.appendChild(option);
+        });
+        setTimezoneOptions(selectId, results);
+      } catch (error) {
+        console.warn('Timezone search failed:', error);
+      }
+    }, 250);
   });
+}
+
+// Dropdown options: the given zones plus the current selection (kept
+// selected), then "Custom Timezone"
+function setTimezoneOptions(selectId, zones) {
+  const select = document.getElementById(selectId);
+  const selected = select.value;
+  const current = timezones.get(selected);
+  const list = current && !zones.some(tz => String(tz.id) === selected) ? [current, ...zones] : zones;
+
+  select.innerHTML = '<option value="">-- Select a city --</option>';
+  list.forEach(tz => select.appendChild(timezoneOption(tz)));
 
-  // Add "Custom Timezone" option at the end
   const customOption = document.createElement('option');
   customOption.value = 'custom';
   customOption.textContent = '-- Custom Timezone --';
   select.appendChild(customOption);
+
+  select.value = selected;
+}
+
+function timezoneOption(tz) {
+  const option = document.createElement('option');
+  option.value = tz.id;
+  option.textContent = tz.name;
+  option.dataset.tz = tz.tz;
+  return option;
+}
+
+// Select a zone in a dropdown, adding it to the options if not listed
+function selectTimezone(selectId, tz) {
+  const select = document.getElementById(selectId);
+  if (![...select.options].some(option => option.value === String(tz.id))) {
+    select.insertBefore(timezoneOption(tz), select.querySelector('option[value="custom"]'));
+  }
+  select.value = tz.id;
 }
 
 // Update hidden fields and display when dropdown changes
@@ -155,7 +240,7 @@ function updateTimezoneFields(event) {
     if (customDiv) customDiv.style.display = 'none';
 
     // Use predefined timezone
-    const tz = timezones[selectedIndex];
+    const tz = timezones.get(selectedIndex);
 
     // Update hidden fields
     document.getElementById(prefix + 'Label').value = tz.name;
@@ -167,29 +252,23 @@ function updateTimezoneFields(event) {
   }
 }
 
-// Set dropdown selection based on label and timezone string
-function setTimezoneDropdown(prefix, label, tz) {
-  // Try to find exact match by name and TZ
-  let index = timezones.findIndex(t => t.name === label && t.tz === tz);
-
-  // If no exact match, try matching just by city name (strip country)
-  if (index === -1) {
-    const cityOnly = label.split(',')[0].trim();
-    index = timezones.findIndex(t => {
-      const tzCity = t.name.split(',')[0].trim();
-      return tzCity === cityOnly && t.tz === tz;
-    });
-  }
-
-  // If still no match, try matching just by timezone string
-  if (index === -1) {
-    index = timezones.findIndex(t => t.tz === tz);
+// Set dropdown selection based on label and timezone string. The zone is
+// looked up on the device by city name; no catalog match means custom.
+async function setTimezoneDropdown(prefix, label, tz) {
+  const cityOnly = label.split(',')[0].trim();
+  let matchedTz;
+  try {
+    const results = await searchTimezones(cityOnly);
+    // Exact match by name and TZ, else by city name (strip country) and TZ
+    matchedTz = results.find(t => t.name === label && t.tz === tz) ||
+                results.find(t => t.name.split(',')[0].trim() === cityOnly && t.tz === tz);
+  } catch (error) {
+    console.warn('Timezone lookup failed:', error);
   }
 
-  if (index !== -1) {
+  if (matchedTz) {
     // Found a match - use the timezone from the list
-    const matchedTz = timezones[index];
-    document.getElementById(prefix + 'Select').value = index;
+    selectTimezone(prefix + 'Select', matchedTz);
     document.getElementById(prefix + 'Label').value = matchedTz.name;
     document.getElementById(prefix + 'Tz').value = matchedTz.tz;
     document.getElementById(prefix + 'TzDisplay').textContent = matchedTz.tz;
@@ -283,14 +362,19 @@ async function loadState() {
     document.getElementById('screenFlipInterval').value = data.screenFlipInterval || 8;
     document.getElementById('debugLevel').value = data.debugLevel || 3;
 
-    // Update form fields (only on explicit load, not during polling)
+    // Update form fields (only on explicit load, not during polling).
+    // One lookup at a time: the device serves one connection at a time
     if (data.homeCity) {
-      setTimezoneDropdown('home', data.homeCity.label, data.homeCity.tz);
+      await setTimezoneDropdown('home', data.homeCity.label, data.homeCity.tz);
     }
 
-    if (data.remoteCities && data.remoteCities.length >= 5) {
-      for (let i = 0; i < 5; i++) {
-        setTimezoneDropdown(`remote${i}`, data.remoteCities[i].label, data.remoteCities[i].tz);
+    if (data.maxRemoteCities) {
+      maxRemoteCities = data.maxRemoteCities;
+    }
+    if (data.remoteCities && data.remoteCities.length >= MIN_REMOTE_CITIES) {
+      setRemoteCityCount(data.remoteCities.length);
+      for (let i = 0; i < data.remoteCities.length; i++) {
+        await setTimezoneDropdown(`remote${i}`, data.remoteCities[i].label, data.remoteCities[i].tz);
       }
     }
 
@@ -313,30 +397,16 @@ async function handleSaveConfig(event) {
       label: formData.get('homeLabel'),
       tz: formData.get('homeTz')
     },
-    remoteCities: [
-      {
-        label: formData.get('remote0Label'),
-        tz: formData.get('remote0Tz')
-      },
-      {
-        label: formData.get('remote1Label'),
-        tz: formData.get('remote1Tz')
-      },
-      {
-        label: formData.get('remote2Label'),
-        tz: formData.get('remote2Tz')
-      },
-      {
-        label: formData.get('remote3Label'),
-        tz: formData.get('remote3Tz')
-      },
-      {
-        label: formData.get('remote4Label'),
-        tz: formData.get('remote4Tz')
-      }
-    ]
+    remoteCities: []
   };
 
+  for (let i = 0; i < remoteCityCount; i++) {
+    config.remoteCities.push({
+      label: formData.get(`remote${i}Label`),
+      tz: formData.get(`remote${i}Tz`)
+    });
+  }
+
   try {
     const response = await fetch('/api/config', {
       method: 'POST',
@@ -0,0 +1,130 @@
+/*
+ * clock_geometry.h - Fixed-point analogue clock geometry
+ *
+ * Hand and marker directions come from constexpr tables instead of float
+ * cos()/sin() on every draw and erase:
+ *   kMinuteDirs[60]  - minute and second hand positions (6 degrees apart)
+ *   kHourDirs[720]   - hour hand positions, one per minute of 12 hours
+ *                      (0.5 degrees apart)
+ *   kSweepDirs[1800] - sweeping second hand, 30 positions per second
+ * Each entry is a unit vector in Q14 fixed point (16384 = 1.0) in screen
+ * coordinates: position 0 points at 12 o'clock (-y), positions run
+ * clockwise. The tables are built at compile time (Taylor series), so they
+ * live in flash and cost no startup time.
+ *
+ * Thick hands are one filled triangle: a base across the centre, one
+ * thickness wide, tapering to the tip. Drawing and erasing the same triangle
+ * covers exactly the same pixels. No Arduino dependencies (host buildable).
+ */
+
+#ifndef CLOCK_GEOMETRY_H
+#define CLOCK_GEOMETRY_H
+
+#include <stdint.h>
+
+#define CLOCK_Q 14  // Fraction bits of the direction vectors
+
+struct ClockDir {
+  int16_t x;  // sin(angle), Q14
+  int16_t y;  // -cos(angle), Q14 (screen y grows downward)
+};
+
+template <int N>
+struct ClockDirTable {
+  ClockDir dir[N];
+  constexpr const ClockDir &operator[](int i) const { return dir[i]; }
+};
+
+// sin(x) for |x| <= pi/2 (compile time only)
+constexpr double clockSinSeries(double x) {
+  double term = x;
+  double sum = x;
+  for (int n = 1; n < 12; n++) {
+    term *= -x * x / ((2 * n) * (2 * n + 1));
+    sum += term;
+  }
+  return sum;
+}
+
+// sin(2*pi * num / den), reduced to the first quadrant (compile time only)
+constexpr double clockSinTurn(int num, int den) {
+  const double kPi = 3.14159265358979323846;
+  double turn = (double)(((num % den) + den) % den) / den;  // [0, 1)
+  double sign = 1.0;
+  if (turn >= 0.5) {  // sin(x + pi) = -sin(x)
+    turn -= 0.5;
+    sign = -1.0;
+  }
+  if (turn > 0.25) {  // sin(pi - x) = sin(x)
+    turn = 0.5 - turn;
+  }
+  return sign * clockSinSeries(2.0 * kPi * turn);
+}
+
+constexpr int16_t clockQ(double v) {
+  double scaled = v * (1 << CLOCK_Q);
+  return (int16_t)(scaled < 0 ? scaled - 0.5 : scaled + 0.5);
+}
+
+template <int N>
+constexpr ClockDirTable<N> makeClockDirs() {
+  ClockDirTable<N> table{};
+  for (int i = 0; i < N; i++) {
+    // x = sin(a), y = -cos(a) = -sin(a + quarter turn)
+    table.dir[i].x = clockQ(clockSinTurn(i, N));
+    table.dir[i].y = clockQ(-clockSinTurn(4 * i + N, 4 * N));
+  }
+  return table;
+}
+
+constexpr ClockDirTable<60> kMinuteDirs = makeClockDirs<60>();
+constexpr ClockDirTable<720> kHourDirs = makeClockDirs<720>();
+
+#define CLOCK_SWEEP_STEPS 30  // Sweep positions per second
+constexpr ClockDirTable<60 * CLOCK_SWEEP_STEPS> kSweepDirs = makeClockDirs<60 * CLOCK_SWEEP_STEPS>();
+
+static_assert(kMinuteDirs[0].x == 0 && kMinuteDirs[0].y == -(1 << CLOCK_Q), "12 o'clock points up");
+static_assert(kMinuteDirs[15].x == (1 << CLOCK_Q) && kMinuteDirs[15].y == 0, "3 o'clock points right");
+static_assert(kMinuteDirs[30].y == (1 << CLOCK_Q), "6 o'clock points down");
+static_assert(kHourDirs[12 * 7].x == kMinuteDirs[7].x && kHourDirs[12 * 7].y == kMinuteDirs[7].y,
+              "Hour table contains the minute positions");
+static_assert(kSweepDirs[CLOCK_SWEEP_STEPS * 7].x == kMinuteDirs[7].x &&
+              kSweepDirs[CLOCK_SWEEP_STEPS * 7].y == kMinuteDirs[7].y,
+              "Sweep table contains the second positions");
+
+// Hour hand position (0-719) for a time of day
+constexpr int clockHourPos(int hour, int minute) {
+  return (hour % 12) * 60 + minute;
+}
+
+// Sweep position (0-1799) for second + ms into the second
+constexpr int clockSweepPos(int second, int ms) {
+  return second * CLOCK_SWEEP_STEPS + ms * CLOCK_SWEEP_STEPS / 1000;
+}
+
+// Round a Q14 product to whole pixels
+constexpr int clockRound(int32_t q) {
+  return (int)((q + (1 << (CLOCK_Q - 1))) >> CLOCK_Q);
+}
+
+// Point length pixels from (cx, cy) along dir
+inline void clockPoint(int cx, int cy, const ClockDir &dir, int length, int *x, int *y) {
+  *x = cx + clockRound((int32_t)dir.x * length);
+  *y = cy + clockRound((int32_t)dir.y * length);
+}
+
+// Triangle of a thick hand: base corners (x0, y0), (x1, y1) across the
+// centre, thickness wide, and the tip (x2, y2)
+inline void clockHandTriangle(int cx, int cy, const ClockDir &dir, int length, int thickness,
+                              int *x0, int *y0, int *x1, int *y1, int *x2, int *y2) {
+  // Perpendicular (dir rotated 90 degrees), scaled to half the thickness
+  int px = clockRound((int32_t)-dir.y * thickness / 2);
+  int py = clockRound((int32_t)dir.x * thickness / 2);
+  *x0 = cx + px;
+  *y0 = cy + py;
+  *x1 = cx - px;
+  *y1 = cy - py;
+  clockPoint(cx, cy, dir, length, x2, y2);
+}
+
+#endif // CLOCK_GEOMETRY_H
@@ -22,4 +22,97 @@
 // Sensor update interval (milliseconds)
 #define SENSOR_UPDATE_INTERVAL 10000  // 10 seconds
 
+// =========================
+// City Count
+// =========================
+// Remote cities (the home city is extra). Each screen layout shows
+// REMOTE_ROWS_PER_PAGE remote rows; with more cities configured the rows page
+// through them every REMOTE_PAGE_INTERVAL_SEC seconds.
+#define MAX_REMOTE_CITIES 24
+#define MAX_CITIES (MAX_REMOTE_CITIES + 1)  // Home + remotes
+#define MIN_REMOTE_CITIES 5
+#define REMOTE_ROWS_PER_PAGE 5
+#define REMOTE_PAGE_INTERVAL_SEC 10
+
+// =========================
+// Widget Compositor
+// =========================
+// Dirty screen rects are composed off-screen and pushed as one window each.
+// Rects larger than COMPOSE_MAX_PIXELS are split into horizontal pieces.
+// The pool keeps COMPOSE_POOL_SIZE sprites (reused by size, each with its
+// loaded font), so worst case RAM is pool size x max pixels x 2 bytes.
+#define COMPOSE_POOL_SIZE 3
+#define COMPOSE_MAX_PIXELS 4096
+
+// Pre-rendered "0123456789:" strips for the time fonts (RGB565). With the
+// bundled NotoSans fonts kFontTime needs ~12.5 KB and kFontLabel ~5 KB;
+// a font that doesn't fit the budget is drawn through the font instead.
+#define GLYPH_CACHE_BUDGET 20480
+
+// =========================
+// Display DMA
+// =========================
+// Full-screen layouts are sent in DMA_BAND_LINES-line bands from two
+// alternating sprite buffers (2 x 320 x 16 x 2 bytes = 20 KB), one band per
+// loop pass, so the web server and OTA keep running during a redraw.
+// Set DISPLAY_DMA_ENABLED to 0 to paint layouts in one blocking call (the
+// old behaviour) and compare /api/state staticRedraw.maxLoopUs.
+#define DISPLAY_DMA_ENABLED 1
+#define DMA_BAND_LINES 16  // Must divide both panel dimensions (240, 320)
+
+// Each static layer (portrait, landscape, alternate portrait) is run-length
+// encoded on its first banded paint and restored from the runs afterwards.
+// Capture starts with this many bytes (4 per run) and shrinks to fit; a
+// layer that needs more is drawn from scratch each time. Host render check:
+// portrait ~4.4 KB, alternate ~2.2 KB, landscape ~9.7 KB (its anti-aliased
+// stand-ins for the bitmap fonts cost more runs than the device's fonts).
+#define STATIC_CACHE_BUDGET 12288
+
+// =========================
+// Portrait Screen Slide
+// =========================
+// With SLIDE_TRANSITION_ENABLED the portrait screen flip (standard <->
+// alternate) slides the new screen up over SLIDE_FPS frames per second, one
+// DMA band per frame, using the panel's hardware vertical scroll
+// (ILI9341/ST7789): 320 / DMA_BAND_LINES = 20 frames, ~0.67 s at 30 fps.
+// Other panel drivers, or no RAM for the band buffers, repaint as before.
+#define SLIDE_TRANSITION_ENABLED 1
+#define SLIDE_FPS 30
+
+// =========================
+// Anti-aliased Clock Sprite
+// =========================
+// With CLOCK_SPRITE_ENABLED the analogue clock disc (face + hands) is
+// rendered every frame into an off-screen sprite with TFT_eSPI's smooth
+// primitives (drawSmoothCircle, drawWideLine, drawWedgeLine) and pushed in
+// one transfer: no erase pass, no ghosting. Costs a (2r+1)^2 x 2 byte buffer
+// (~20 KB landscape, ~24 KB alternate screen); if it can't be allocated the
+// clock falls back to direct drawing. CLOCK_SPRITE_FPS frames per second
+// (1-30) while a clock is on screen; /api/state clockSprite reports render
+// and push time per frame.
+#define CLOCK_SPRITE_ENABLED 0
+#define CLOCK_SPRITE_FPS 1
+
+// =========================
+// Sweeping Second Hand
+// =========================
+// With CLOCK_SWEEP_ENABLED the second hand moves CLOCK_SWEEP_FPS (10-30)
+// times per second instead of ticking once, positioned from gettimeofday()
+// microseconds (the NTP-aligned second). Each frame erases and restores only
+// the pixels the old hand line crossed. Overrides CLOCK_SPRITE_FPS when both
+// are enabled. /api/state clockHands reports achieved fps and CPU share.
+#define CLOCK_SWEEP_ENABLED 0
+#define CLOCK_SWEEP_FPS 20
+
+// =========================
+// Diagnostics Console
+// =========================
+// The diagnostics screen (touch to open) refreshes once a second: heap,
+// uptime and RSSI are redrawn in place when they change, and new log
+// entries are appended to RECENT LOGS (portrait: in a hardware scroll area
+// on ILI9341/ST7789, so older lines move up without being redrawn). With
+// DIAGNOSTICS_CONSOLE_HOLD 1 the first page stays open until touched, to be
+// left watching a unit; 0 closes it after 15 s like the timing page.
+#define DIAGNOSTICS_CONSOLE_HOLD 1
+
 #endif // CONFIG_H
@@ -0,0 +1,82 @@
+/*
+ * render_timing.h - Fixed-bucket microsecond histograms for render timing
+ *
+ * Each render entry point records its duration into one LatencyHistogram.
+ * Buckets are log-linear: exact below 8 us, then 4 buckets per power of two
+ * (each at most 25% wide) up to ~16 s, so recording is a count-leading-zeros
+ * and an increment - cheap enough to leave on in production. Percentiles are
+ * reported as the upper bound of the bucket they fall in.
+ *
+ * No Arduino dependencies (host buildable); the caller supplies durations.
+ */
+
+#ifndef RENDER_TIMING_H
+#define RENDER_TIMING_H
+
+#include <stdint.h>
+
+#define LATENCY_LINEAR 8       // Exact buckets 0-7 us
+#define LATENCY_SUB_BITS 2     // 4 buckets per power of two above that
+#define LATENCY_MAX_OCTAVE 23  // Top bucket ends at 2^24 us (~16.8 s)
+#define LATENCY_BUCKETS \
+  (LATENCY_LINEAR + (LATENCY_MAX_OCTAVE - 2) * (1 << LATENCY_SUB_BITS))
+
+// Bucket holding a duration of us microseconds
+constexpr int latencyBucket(uint32_t us) {
+  if (us < LATENCY_LINEAR) return (int)us;
+  int octave = 31 - __builtin_clz(us);  // >= 3
+  if (octave > LATENCY_MAX_OCTAVE) return LATENCY_BUCKETS - 1;
+  int sub = (int)(us >> (octave - LATENCY_SUB_BITS)) & ((1 << LATENCY_SUB_BITS) - 1);
+  return LATENCY_LINEAR + (octave - 3) * (1 << LATENCY_SUB_BITS) + sub;
+}
+
+// Largest duration (us) that falls in bucket
+constexpr uint32_t latencyBucketMax(int bucket) {
+  if (bucket < LATENCY_LINEAR) return (uint32_t)bucket;
+  int octave = (bucket - LATENCY_LINEAR) / (1 << LATENCY_SUB_BITS) + 3;
+  int sub = (bucket - LATENCY_LINEAR) % (1 << LATENCY_SUB_BITS);
+  uint32_t step = 1u << (octave - LATENCY_SUB_BITS);
+  return (uint32_t)((1 << LATENCY_SUB_BITS) + sub + 1) * step - 1;
+}
+
+static_assert(latencyBucket(7) == 7 && latencyBucket(8) == 8 && latencyBucket(9) == 8 &&
+              latencyBucket(10) == 9, "Linear/log boundary");
+static_assert(latencyBucketMax(latencyBucket(1000)) >= 1000 &&
+              latencyBucketMax(latencyBucket(1000) - 1) < 1000, "Bucket bounds");
+static_assert(latencyBucket(0xFFFFFFFFu) == LATENCY_BUCKETS - 1, "Overflow bucket");
+
+struct LatencyHistogram {
+  uint32_t counts[LATENCY_BUCKETS];
+  uint32_t count;
+  uint32_t maxUs;
+  uint64_t totalUs;
+
+  void record(uint32_t us) {
+    counts[latencyBucket(us)]++;
+    count++;
+    totalUs += us;
+    if (us > maxUs) maxUs = us;
+  }
+
+  // Upper bound of the bucket holding the pct-th percentile (0 if empty)
+  uint32_t percentile(uint32_t pct) const {
+    if (count == 0) return 0;
+    uint64_t rank = ((uint64_t)count * pct + 99) / 100;  // 1-based, rounded up
+    if (rank == 0) rank = 1;
+    uint64_t seen = 0;
+    for (int b = 0; b < LATENCY_BUCKETS; b++) {
+      seen += counts[b];
+      if (seen >= rank) {
+        uint32_t bound = latencyBucketMax(b);
+        return bound < maxUs ? bound : maxUs;
+      }
+    }
+    return maxUs;
+  }
+
+  uint32_t averageUs() const {
+    return count ? (uint32_t)(totalUs / count) : 0;
+  }
+};
+
+#endif // RENDER_TIMING_H
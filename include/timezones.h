@@ -18,11 +18,16 @@
  * - AEDT = Daylight saving time name
  * - M10.1.0 = DST starts month 10, week 1, Sunday
  * - M4.1.0/3 = DST ends month 4, week 1, Sunday at 3am
+ *
+ * Every string is parsed at compile time into timezoneCatalog (flash);
+ * a malformed string fails the build via static_assert.
  */
 
 #ifndef TIMEZONES_H
 #define TIMEZONES_H
 
+#include "tz_engine.h"
+
 // ======================== TIMEZONE CONFIGURATION ========================
 struct TimezoneInfo {
   const char* name;
@@ -31,7 +36,7 @@ struct TimezoneInfo {
 
 // Expanded timezone array with 88 global timezones (organized by region)
 // Default timezone is index 0 (Sydney, Australia)
-const TimezoneInfo timezones[] = {
+constexpr TimezoneInfo timezones[] = {
   // ==================== AUSTRALIA & OCEANIA (0-11) ====================
   {"Sydney, Australia", "AEST-10AEDT,M10.1.0,M4.1.0/3"},  // INDEX 0 - DEFAULT
   {"Adelaide, Australia", "ACST-9:30ACDT,M10.1.0,M4.1.0/3"},
@@ -164,6 +169,95 @@ const TimezoneInfo timezones[] = {
 };
 
 // Calculate number of timezones automatically
-const int numTimezones = sizeof(timezones) / sizeof(timezones[0]);
+constexpr int numTimezones = sizeof(timezones) / sizeof(timezones[0]);
+
+// ======================== COMPILE-TIME PARSED CATALOG ========================
+// timezoneCatalog.tz[i] is timezones[i].tzString already parsed, so selecting
+// a catalog city is a table copy - no runtime parsing.
+struct ParsedTimezoneCatalog {
+  ParsedTimezone tz[numTimezones];
+};
+
+constexpr ParsedTimezoneCatalog buildTimezoneCatalog() {
+  ParsedTimezoneCatalog catalog{};
+  for (int i = 0; i < numTimezones; i++) {
+    catalog.tz[i] = parseTimezone(timezones[i].tzString);
+  }
+  return catalog;
+}
+
+// Index of the first malformed entry, or -1 if all parse cleanly
+constexpr int firstInvalidTimezone() {
+  for (int i = 0; i < numTimezones; i++) {
+    if (!isValidTimezoneString(timezones[i].tzString)) return i;
+  }
+  return -1;
+}
+
+// Instantiated with that index, so a failure names the entry: "In
+// instantiation of 'struct TimezoneStringCheck<5>'" is timezones[5]
+template <int Index>
+struct TimezoneStringCheck {
+  static_assert(Index < 0, "timezones[Index]: malformed POSIX TZ string (Index is the template argument above)");
+  static constexpr bool ok = true;
+};
+static_assert(TimezoneStringCheck<firstInvalidTimezone()>::ok, "timezones[]: malformed POSIX TZ string");
+
+constexpr ParsedTimezoneCatalog timezoneCatalog = buildTimezoneCatalog();
+
+// ======================== COMPILE-TIME NAME INDEX ========================
+// timezoneNameIndex.order[] lists catalog indices sorted by name (case
+// insensitive), so /api/timezones?q= can binary-search prefixes in flash
+// instead of building the whole list in RAM.
+constexpr char asciiLower(char c) {
+  return (c >= 'A' && c <= 'Z') ? (char)(c - 'A' + 'a') : c;
+}
+
+// Case-insensitive strcmp
+constexpr int compareNameCI(const char* a, const char* b) {
+  while (*a && asciiLower(*a) == asciiLower(*b)) {
+    a++;
+    b++;
+  }
+  return (unsigned char)asciiLower(*a) - (unsigned char)asciiLower(*b);
+}
+
+struct TimezoneNameIndex {
+  uint8_t order[numTimezones];
+};
+
+constexpr TimezoneNameIndex buildTimezoneNameIndex() {
+  TimezoneNameIndex index{};
+  for (int i = 0; i < numTimezones; i++) {
+    // Insertion sort: ~100 entries, runs once in the compiler
+    int j = i;
+    while (j > 0 && compareNameCI(timezones[index.order[j - 1]].name, timezones[i].name) > 0) {
+      index.order[j] = index.order[j - 1];
+      j--;
+    }
+    index.order[j] = i;
+  }
+  return index;
+}
+
+// Names and TZ strings are emitted into JSON verbatim (no escaping)
+constexpr bool isJsonSafe(const char* s) {
+  for (; *s; s++) {
+    if (*s == '"' || *s == '\\' || (unsigned char)*s < 0x20) return false;
+  }
+  return true;
+}
+
+constexpr bool catalogIsJsonSafe() {
+  for (int i = 0; i < numTimezones; i++) {
+    if (!isJsonSafe(timezones[i].name) || !isJsonSafe(timezones[i].tzString)) return false;
+  }
+  return true;
+}
+
+static_assert(numTimezones <= 256, "timezoneNameIndex stores uint8_t indices");
+static_assert(catalogIsJsonSafe(), "timezones[]: name/TZ string needs JSON escaping");
+
+constexpr TimezoneNameIndex timezoneNameIndex = buildTimezoneNameIndex();
 
 #endif // TIMEZONES_H
@@ -0,0 +1,77 @@
+/*
+ * tz_db.h - Optional zoneinfo transition database (data/tzdb.bin on LittleFS)
+ *
+ * POSIX rules only describe the current DST rule. For zones whose rules have
+ * changed (or will change), tools/tzdb/mktzdb.py packs the IANA zoneinfo
+ * transitions into one sorted binary file. A city selects it by using
+ * ":Area/City" (e.g. ":Europe/London") as its timezone string.
+ *
+ * Nothing is loaded into RAM: zone lookup binary-searches the name index and
+ * offset lookup binary-searches that zone's transition records, both straight
+ * from the file (stdio, so the same code runs on the host). Each city keeps
+ * the segment it is currently in [segStartUtc, segEndUtc), so the file is only
+ * touched again when a transition is crossed - a couple of times a year.
+ * After the last stored transition the zone's POSIX footer rule takes over
+ * (tz_engine isDstActive() with its per-year cache).
+ *
+ * File layout: see tools/tzdb/mktzdb.py (TZDB_* constants below must match).
+ */
+
+#ifndef TZ_DB_H
+#define TZ_DB_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <time.h>
+
+#include "tz_engine.h"
+
+#define TZDB_MAGIC "CYTZ"
+#define TZDB_VERSION 1
+#define TZDB_HEADER_SIZE 16
+#define TZDB_INDEX_ENTRY_SIZE 48
+#define TZDB_RECORD_SIZE 8
+#define TZDB_NAME_LEN 36  // Incl. terminator
+
+// One city's view of a database zone: where its records are, plus the cached
+// segment containing the last queried instant.
+struct TzDbZone {
+  uint32_t transOffset;     // File offset of the first transition record
+  uint16_t transCount;      // Number of transition records
+  int16_t initialOffsetMins;  // Offset before the first record
+  bool hasFooter;           // Footer POSIX rule present (applies after last record)
+  ParsedTimezone footer;    // Parsed footer rule
+
+  // Active segment cache
+  time_t segStartUtc;       // Segment valid from (inclusive)
+  time_t segEndUtc;         // Segment valid until (exclusive)
+  int16_t segOffsetMins;    // Offset in force during the segment
+  bool segIsDst;
+  bool segUsesFooter;       // Past the last record: ask the footer rule
+};
+
+// Validate the header and remember the path ("/littlefs/tzdb.bin" on ESP32).
+// Returns false (and disables the database) if missing or malformed.
+bool tzdbOpen(const char* path);
+
+// Database opened successfully
+bool tzdbAvailable();
+
+// Number of zones in the database (0 if unavailable)
+uint16_t tzdbZoneCount();
+
+// Copy the name of zone index (sorted order) into out. Returns false if out of range.
+bool tzdbZoneName(uint16_t index, char* out, size_t len);
+
+// Look up an IANA name ("Europe/London", no leading ':') and prepare zone.
+// Binary search over the on-file index; reads one entry per probe.
+bool tzdbFindZone(const char* name, TzDbZone* zone);
+
+// UTC offset (minutes) in force at utc. Answered from the cached segment when
+// possible; otherwise binary-searches the zone's records in the file.
+int16_t tzdbOffsetAt(time_t utc, TzDbZone* zone, bool* isDst);
+
+// File reads since boot (index probes + record reads), for diagnostics
+uint32_t tzdbFileReads();
+
+#endif // TZ_DB_H
@@ -0,0 +1,316 @@
+/*
+ * tz_engine.h - POSIX TZ string parser and UTC -> local time conversion
+ *
+ * Replaces setenv("TZ") + localtime_r(), which leaks ~30-40 bytes per call
+ * on ESP32. Has no Arduino dependencies so it also builds for the PlatformIO
+ * `native` environment (see tools/tzbench/).
+ *
+ * The parser is constexpr (C++17) so timezones.h can turn the whole catalog
+ * into ParsedTimezone entries at compile time; user-entered strings use the
+ * same functions at runtime.
+ *
+ * POSIX TZ format: STD offset [DST [offset], start [/time], end [/time]]
+ * Example: "AEST-10AEDT,M10.1.0/2,M4.1.0/3"
+ * Note: POSIX sign is inverted - negative offset means AHEAD of UTC
+ *
+ * Supported rule formats:
+ *   Mm.w.d[/h] - day d (0=Sun) of week w (5=last) of month m
+ *   Jn[/h]     - Julian day 1-365, Feb 29 is never counted
+ *   n[/h]      - zero-based day of year 0-365, Feb 29 is counted
+ *
+ * ":Area/City" strings are not rules but names in the optional zoneinfo
+ * database (tz_db.h); the caller resolves those and sets ParsedTimezone::db.
+ */
+
+#ifndef TZ_ENGINE_H
+#define TZ_ENGINE_H
+
+#include <stdint.h>
+#include <time.h>
+
+enum DstRuleType : uint8_t {
+  DST_RULE_MONTH_WEEK_DAY = 0,  // Mm.w.d
+  DST_RULE_JULIAN_NO_LEAP,      // Jn
+  DST_RULE_DAY_OF_YEAR          // n
+};
+
+struct DstRule {
+  uint8_t type;     // DstRuleType
+  uint8_t month;    // 1-12 (Mm.w.d only)
+  uint8_t week;     // 1-5 (5 = last)
+  uint8_t dow;      // 0-6 (0 = Sunday)
+  int16_t hour;     // Transition hour (default 2, POSIX allows -167..167)
+  int8_t minute;    // Transition minute, same sign as hour ("/2:45")
+  uint16_t yday;    // Julian / zero-based day (Jn and n only)
+};
+
+struct TzDbZone;  // tz_db.h
+
+struct ParsedTimezone {
+  int16_t stdOffsetMins;   // Standard time offset in minutes from UTC
+  int16_t dstOffsetMins;   // DST offset in minutes from UTC (0 if no DST)
+  bool hasDst;
+  DstRule dstStart;        // When DST begins
+  DstRule dstEnd;          // When DST ends
+
+  // Per-year cache of DST transition instants (UTC), rebuilt lazily by
+  // isDstActive() when "now" leaves [yearStartUtc, yearEndUtc).
+  // cacheYear == 0 means not built yet (parseTimezoneString() zeroes it).
+  int16_t cacheYear;       // Local (standard time) year the instants belong to
+  time_t yearStartUtc;     // Jan 1 00:00 local standard time, as UTC
+  time_t yearEndUtc;       // Jan 1 00:00 of the following year, as UTC
+  time_t dstStartUtc;      // DST start instant this year
+  time_t dstEndUtc;        // DST end instant this year
+
+  // ":Area/City" zones resolved from the tzdb.bin transition database
+  // (tz_db.h). When set, the rule fields above are unused.
+  TzDbZone* db;
+};
+
+// =========================
+// Parser (constexpr: also used to build the timezones[] catalog at compile time)
+// =========================
+
+// Skip a zone abbreviation: alphabetic ("AEST") or quoted ("<+0530>").
+// Returns nullptr if the name is missing or shorter than 3 characters.
+constexpr const char* skipZoneName(const char* p) {
+  const char* start = p;
+  if (*p == '<') {
+    while (*p && *p != '>') p++;
+    if (*p != '>') return nullptr;
+    return (p - start > 3) ? p + 1 : nullptr;
+  }
+  while (*p && ((*p >= 'A' && *p <= 'Z') || (*p >= 'a' && *p <= 'z'))) p++;
+  return (p - start >= 3) ? p : nullptr;
+}
+
+// Parse hours:minutes offset string, returns minutes
+// Handles formats: "10", "-5", "5:30", "-9:30"
+constexpr int16_t parseOffset(const char* str, const char** endPtr) {
+  int sign = 1;
+  if (*str == '-') {
+    sign = -1;
+    str++;
+  } else if (*str == '+') {
+    str++;
+  }
+
+  int hours = 0;
+  while (*str >= '0' && *str <= '9') {
+    hours = hours * 10 + (*str - '0');
+    str++;
+  }
+
+  int mins = 0;
+  if (*str == ':') {
+    str++;
+    while (*str >= '0' && *str <= '9') {
+      mins = mins * 10 + (*str - '0');
+      str++;
+    }
+  }
+
+  if (endPtr) *endPtr = str;
+  // POSIX sign is inverted: -10 means UTC+10, so we negate
+  return -sign * (hours * 60 + mins);
+}
+
+// Parse DST rule in M.w.d/h, Jn/h or n/h format
+// M = month (1-12), w = week (1-5), d = day (0-6), h = hour
+// Returns false if the rule is malformed or out of range.
+constexpr bool parseDstRule(const char* str, DstRule* rule, const char** endPtr) {
+  *rule = DstRule{};
+
+  if (*str == 'M') {
+    rule->type = DST_RULE_MONTH_WEEK_DAY;
+    str++;
+
+    while (*str >= '0' && *str <= '9') {
+      rule->month = rule->month * 10 + (*str - '0');
+      str++;
+    }
+    if (*str != '.') return false;
+    str++;
+
+    rule->week = *str - '0';
+    str++;
+    if (*str != '.') return false;
+    str++;
+
+    rule->dow = *str - '0';
+    str++;
+
+    if (rule->month < 1 || rule->month > 12) return false;
+    if (rule->week < 1 || rule->week > 5) return false;
+    if (rule->dow > 6) return false;
+  } else if (*str == 'J' || (*str >= '0' && *str <= '9')) {
+    rule->type = (*str == 'J') ? DST_RULE_JULIAN_NO_LEAP : DST_RULE_DAY_OF_YEAR;
+    if (*str == 'J') str++;
+    if (*str < '0' || *str > '9') return false;
+    while (*str >= '0' && *str <= '9') {
+      rule->yday = rule->yday * 10 + (*str - '0');
+      str++;
+    }
+    if (rule->yday > 365) return false;
+    if (rule->type == DST_RULE_JULIAN_NO_LEAP && rule->yday < 1) return false;
+  } else {
+    return false;
+  }
+
+  // Optional time [-]h[:mm] (default 2:00); zoneinfo footers use negative
+  // hours and minutes, e.g. "M3.5.0/-1" and "M9.5.0/2:45"
+  rule->hour = 2;
+  if (*str == '/') {
+    str++;
+    int sign = 1;
+    if (*str == '-' || *str == '+') {
+      sign = (*str == '-') ? -1 : 1;
+      str++;
+    }
+    if (*str < '0' || *str > '9') return false;
+    int hour = 0;
+    while (*str >= '0' && *str <= '9') {
+      hour = hour * 10 + (*str - '0');
+      str++;
+    }
+    if (hour > 167) return false;  // POSIX allows up to 167h
+    int minute = 0;
+    if (*str == ':') {
+      str++;
+      if (*str < '0' || *str > '5' || str[1] < '0' || str[1] > '9') return false;
+      minute = (str[0] - '0') * 10 + (str[1] - '0');
+      str += 2;
+    }
+    rule->hour = sign * hour;
+    rule->minute = sign * minute;
+  }
+
+  if (endPtr) *endPtr = str;
+  return true;
+}
+
+// Offset must carry at least one digit after an optional sign
+constexpr bool hasOffsetDigits(const char* p) {
+  if (*p == '-' || *p == '+') p++;
+  return *p >= '0' && *p <= '9';
+}
+
+// Malformed DST section: fall back to standard time only
+constexpr bool rejectDst(ParsedTimezone* tz) {
+  tz->hasDst = false;
+  tz->dstOffsetMins = tz->stdOffsetMins;
+  tz->dstStart = DstRule{};
+  tz->dstEnd = DstRule{};
+  return false;
+}
+
+// Parse full POSIX TZ string
+// Always fills tz (best effort); returns false if the string is malformed.
+constexpr bool parseTimezoneString(const char* tzStr, ParsedTimezone* tz) {
+  *tz = ParsedTimezone{};
+
+  // Skip STD name
+  const char* p = skipZoneName(tzStr);
+  bool valid = (p != nullptr);
+  if (!p) {
+    p = tzStr;
+    while (*p && ((*p >= 'A' && *p <= 'Z') || (*p >= 'a' && *p <= 'z'))) p++;
+  }
+
+  // Parse STD offset
+  if (!hasOffsetDigits(p)) valid = false;
+  tz->stdOffsetMins = parseOffset(p, &p);
+
+  // Check for DST
+  if (!*p || *p == '\0') {
+    tz->hasDst = false;
+    tz->dstOffsetMins = tz->stdOffsetMins;
+    return valid;
+  }
+
+  // Skip DST name
+  const char* afterName = skipZoneName(p);
+  if (!afterName) return rejectDst(tz);
+  p = afterName;
+
+  // DST offset (optional - defaults to STD + 60 mins)
+  tz->hasDst = true;
+  if (*p == ',' || *p == '\0') {
+    tz->dstOffsetMins = tz->stdOffsetMins + 60;
+  } else {
+    if (!hasOffsetDigits(p)) valid = false;
+    tz->dstOffsetMins = parseOffset(p, &p);
+  }
+
+  // Parse DST start rule
+  if (*p != ',') return rejectDst(tz);
+  p++;
+  if (!parseDstRule(p, &tz->dstStart, &p)) return rejectDst(tz);
+
+  // Parse DST end rule
+  if (*p != ',') return rejectDst(tz);
+  p++;
+  if (!parseDstRule(p, &tz->dstEnd, &p)) return rejectDst(tz);
+
+  return valid && *p == '\0';
+}
+
+// Value-returning wrappers for constant expressions
+constexpr ParsedTimezone parseTimezone(const char* tzStr) {
+  ParsedTimezone tz{};
+  parseTimezoneString(tzStr, &tz);
+  return tz;
+}
+
+constexpr bool isValidTimezoneString(const char* tzStr) {
+  ParsedTimezone tz{};
+  return parseTimezoneString(tzStr, &tz);
+}
+
+// =========================
+// Conversion (runtime, tz_engine.cpp)
+// =========================
+
+// Broken-down local time: only the fields the display needs.
+// Filled by integer days<->civil arithmetic, no gmtime_r/localtime_r.
+struct LocalTime {
+  int16_t year;        // Full year, e.g. 2026
+  uint8_t month;       // 1-12
+  uint8_t day;         // 1-31
+  uint8_t hour;        // 0-23
+  uint8_t minute;      // 0-59
+  uint8_t second;      // 0-59
+  uint8_t wday;        // 0-6 (0 = Sunday)
+  uint16_t yday;       // 0-365
+  int16_t offsetMins;  // UTC offset that was applied (std or DST)
+};
+
+// Days since 1970-01-01 for a proleptic Gregorian date (month 1-12)
+int32_t daysFromCivil(int year, int month, int day);
+
+// Inverse of daysFromCivil()
+void civilFromDays(int32_t days, int* year, int* month, int* day);
+
+// Convert one UTC instant for one timezone
+void utcToLocal(time_t utc, ParsedTimezone* tz, LocalTime* out);
+
+// Convert one UTC instant for count timezones in a single pass
+void utcToLocalBatch(time_t utc, ParsedTimezone* tzs, LocalTime* out, int count);
+
+// Fill a struct tm from a LocalTime (for strftime())
+void localTimeToTm(const LocalTime* lt, struct tm* out);
+
+// Calendar date of a relative to b: -1 = earlier day, 0 = same day, 1 = later day
+int compareLocalDate(const LocalTime* a, const LocalTime* b);
+
+// Write "HH:MM" (6 bytes incl. terminator) without snprintf
+void formatTimeHHMM(const LocalTime* lt, char* out);
+
+// Check if DST is active for given UTC time (may rebuild the year cache,
+// or for tzdb zones re-read the transition segment)
+bool isDstActive(time_t utc, ParsedTimezone* tz);
+
+// Get local time from UTC without using setenv() - NO MEMORY LEAK
+void getLocalTimeNoSetenv(time_t utc, ParsedTimezone* tz, struct tm* out);
+
+#endif // TZ_ENGINE_H
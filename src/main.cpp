@@ -9,11 +9,17 @@
 #include <ArduinoOTA.h>
 #include <ArduinoJson.h>
 #include <time.h>
+#include <esp_sntp.h>
 #include <SPI.h>
 #include <XPT2046_Touchscreen.h>
 #include <Wire.h>
+#include "clock_geometry.h"
 #include "config.h"
+#include "fonts_vlw.h"
+#include "render_timing.h"
 #include "timezones.h"
+#include "tz_db.h"
+#include "tz_engine.h"
 
 // Sensor libraries (conditional based on config.h)
 #ifdef USE_BMP280
@@ -175,6 +181,7 @@ struct LogEntry {
 LogEntry logBuffer[LOG_BUFFER_SIZE];
 int logIndex = 0;
 int logCount = 0;
+uint32_t logTotal = 0;  // Entries ever added (the diagnostics console appends the new ones)
 
 // Add entry to circular log buffer
 void addToLogBuffer(uint8_t level, const char* msg) {
@@ -186,14 +193,21 @@ void addToLogBuffer(uint8_t level, const char* msg) {
   if (logCount < LOG_BUFFER_SIZE) {
     logCount++;
   }
+  logTotal++;
 }
 
 // =========================
 // Diagnostics Screen State
 // =========================
 bool showingDiagnostics = false;
+uint8_t diagnosticsPage = 0;             // 0 = system/logs, 1 = render timing
+const uint8_t DIAGNOSTICS_PAGES = 2;
 unsigned long diagnosticsStartTime = 0;
 const unsigned long DIAGNOSTICS_TIMEOUT = 15000; // 15 seconds
+uint32_t diagRefreshes = 0;     // Live refresh passes while open
+uint32_t diagLinesDrawn = 0;    // Text lines drawn (full draws and refreshes)
+uint32_t diagLogLines = 0;      // Log lines appended to the console
+uint32_t diagLogScrolls = 0;    // Appends that moved the hardware scroll
 
 // ==================================
 // Portrait Screen Rotation State
@@ -201,6 +215,81 @@ const unsigned long DIAGNOSTICS_TIMEOUT = 15000; // 15 seconds
 bool showingAlternateScreen = false;   // Current screen: false=standard, true=alternate
 unsigned long lastScreenFlip = 0;       // Last time screens were flipped
 
+// ==================================
+// Loop Scheduler State (see Next-Event Scheduler)
+// ==================================
+static TaskHandle_t loopTaskHandle = nullptr;  // Woken by touch IRQ
+static uint32_t loopWakeups = 0;               // Total loop() passes (exposed in /api/state)
+static uint32_t loopPassStart = 0;
+static uint32_t loopWindowUs = 0;              // Busy time in the current wall-clock second
+static uint32_t loopCpuUs = 0;                 // ...in the last complete second
+static unsigned long lastNetActivity = 0;      // millis() a web client was last seen
+static bool netActivitySeen = false;
+static bool otaActive = false;                 // OTA update between onStart and onEnd/onError
+void IRAM_ATTR onTouchIrq();
+
+// ==================================
+// Wall Clock (sub-second time source)
+// ==================================
+// SNTP sets the gettimeofday() clock, so its microseconds count from the
+// real (NTP) second boundary. Second ticks, the colon blink and the sweep
+// hand all read it; millis() runs independently of the second boundary.
+struct WallTime {
+  time_t sec;
+  uint32_t us;  // 0-999999 into sec
+};
+
+static WallTime wallNow() {
+  struct timeval tv;
+  gettimeofday(&tv, nullptr);
+  return {tv.tv_sec, (uint32_t)tv.tv_usec};
+}
+
+static uint32_t ntpSyncs = 0;       // SNTP updates since boot
+static time_t lastNtpSync = 0;      // Epoch of the last update
+static uint32_t tickLateUs = 0;     // Second tick start past the boundary (last)
+static uint32_t tickLateMaxUs = 0;
+
+// SNTP callback (lwIP task)
+static void onNtpSync(struct timeval *tv) {
+  ntpSyncs++;
+  lastNtpSync = tv->tv_sec;
+}
+
+// ==================================
+// Render Timing (histograms in render_timing.h)
+// ==================================
+// One histogram per render entry point, always on (~370 bytes each).
+// Served by GET /api/timing and the diagnostics screen's second page.
+enum RenderTimer : uint8_t {
+  RT_TIMES_PORTRAIT,    // drawTimes() in portrait
+  RT_TIMES_LANDSCAPE,   // drawTimes() in landscape (incl. clock hands)
+  RT_ALTERNATE,         // drawAlternatePortraitUpdate()
+  RT_WIDGETS,           // renderWidgets()
+  RT_CLOCK_HANDS,       // One clock frame that drew something
+  RT_STATIC_LAYOUT,     // Layout submit -> labels drawn
+  RT_STATIC_BAND,       // One serviceStaticLayout() pass
+  RT_ENV_DATA,          // drawEnvironmentalData()
+  RT_FONT_LOAD,         // Smooth font load
+  RT_COUNT
+};
+
+static const char *const kRenderTimerNames[RT_COUNT] = {
+  "timesPortrait", "timesLandscape", "alternate", "widgets", "clockHands",
+  "staticLayout", "staticBand", "envData", "fontLoad"
+};
+
+static LatencyHistogram renderTimers[RT_COUNT];
+static uint32_t fontSwitches = 0;  // setFontOn() calls that changed the font
+
+// Records the lifetime of the enclosing scope into one histogram
+struct ScopedRenderTimer {
+  RenderTimer timer;
+  uint32_t start;
+  explicit ScopedRenderTimer(RenderTimer t) : timer(t), start(micros()) {}
+  ~ScopedRenderTimer() { renderTimers[timer].record(micros() - start); }
+};
+
 #define FIRMWARE_VERSION "2.9.0"
 #define OTA_HOSTNAME "WorldClock"
 #define OTA_PASSWORD "change-me"  // TODO: Change this!
@@ -209,8 +298,9 @@ unsigned long lastScreenFlip = 0;       // Last time screens were flipped
 struct Config {
   char homeCityLabel[32];
   char homeCityTz[64];
-  char remoteCities[5][32];    // City labels (expanded to 5)
-  char remoteTzStrings[5][64]; // Timezone strings (expanded to 5)
+  uint8_t remoteCount;         // Remote cities in use (MIN_REMOTE_CITIES..MAX_REMOTE_CITIES)
+  char remoteCities[MAX_REMOTE_CITIES][32];    // City labels
+  char remoteTzStrings[MAX_REMOTE_CITIES][64]; // Timezone strings
   bool landscapeMode;          // Display orientation: true = landscape, false = portrait
   bool flipDisplay;            // Flip display 180°: allows USB on opposite side
   bool useFahrenheit;          // Temperature unit: false = Celsius, true = Fahrenheit
@@ -220,241 +310,72 @@ struct Config {
 
 Config config;
 
+// Home + configured remote cities (index 0 = home, i = remote i - 1)
+static inline int cityCount() {
+  return 1 + config.remoteCount;
+}
+
 // =========================
 // Manual Timezone Calculation (replaces setenv() to fix memory leak)
 // =========================
-// POSIX TZ format: STD offset [DST [offset], start [/time], end [/time]]
-// Example: "AEST-10AEDT,M10.1.0/2,M4.1.0/3"
-// Note: POSIX sign is inverted - negative offset means AHEAD of UTC
-
-struct DstRule {
-  uint8_t month;    // 1-12
-  uint8_t week;     // 1-5 (5 = last)
-  uint8_t dow;      // 0-6 (0 = Sunday)
-  uint8_t hour;     // Transition hour (default 2)
-};
+// Parser + DST engine live in tz_engine.h/.cpp (also built by env:native)
 
-struct ParsedTimezone {
-  int16_t stdOffsetMins;   // Standard time offset in minutes from UTC
-  int16_t dstOffsetMins;   // DST offset in minutes from UTC (0 if no DST)
-  bool hasDst;
-  DstRule dstStart;        // When DST begins
-  DstRule dstEnd;          // When DST ends
-};
-
-// Parsed timezone cache for all 6 cities
-static ParsedTimezone parsedTz[6];
-
-// Parse hours:minutes offset string, returns minutes
-// Handles formats: "10", "-5", "5:30", "-9:30"
-static int16_t parseOffset(const char* str, const char** endPtr) {
-  int sign = 1;
-  if (*str == '-') {
-    sign = -1;
-    str++;
-  } else if (*str == '+') {
-    str++;
-  }
+// Parsed timezone cache for all cities (index 0 = home)
+static ParsedTimezone parsedTz[MAX_CITIES];
 
-  int hours = 0;
-  while (*str >= '0' && *str <= '9') {
-    hours = hours * 10 + (*str - '0');
-    str++;
-  }
+// Optional zoneinfo database on LittleFS (tools/tzdb/mktzdb.py), used by
+// ":Area/City" timezone strings. One slot per city holds its active segment.
+#define TZDB_PATH "/littlefs/tzdb.bin"
+static TzDbZone tzdbZones[MAX_CITIES];
 
-  int mins = 0;
-  if (*str == ':') {
-    str++;
-    while (*str >= '0' && *str <= '9') {
-      mins = mins * 10 + (*str - '0');
-      str++;
-    }
+// Find a TZ string in the built-in catalog, returns index or -1
+int findCatalogTimezone(const char* tzStr) {
+  for (int i = 0; i < numTimezones; i++) {
+    if (strcmp(timezones[i].tzString, tzStr) == 0) return i;
   }
-
-  if (endPtr) *endPtr = str;
-  // POSIX sign is inverted: -10 means UTC+10, so we negate
-  return -sign * (hours * 60 + mins);
+  return -1;
 }
 
-// Parse DST rule in M.w.d/h format
-// M = month (1-12), w = week (1-5), d = day (0-6), h = hour
-static bool parseDstRule(const char* str, DstRule* rule, const char** endPtr) {
-  if (*str != 'M') return false;
-  str++;
-
-  rule->month = 0;
-  while (*str >= '0' && *str <= '9') {
-    rule->month = rule->month * 10 + (*str - '0');
-    str++;
-  }
-  if (*str != '.') return false;
-  str++;
-
-  rule->week = *str - '0';
-  str++;
-  if (*str != '.') return false;
-  str++;
-
-  rule->dow = *str - '0';
-  str++;
-
-  // Optional hour (default 2:00)
-  rule->hour = 2;
-  if (*str == '/') {
-    str++;
-    rule->hour = 0;
-    while (*str >= '0' && *str <= '9') {
-      rule->hour = rule->hour * 10 + (*str - '0');
-      str++;
+// Resolve one configured TZ string: catalog entries are copied from the
+// compile-time parsed table, ":Area/City" names come from tzdb.bin, custom
+// strings go through the runtime parser.
+// Returns true if the string came from the catalog.
+static bool resolveTimezone(const char* tzStr, ParsedTimezone* out, TzDbZone* dbSlot) {
+  if (tzStr[0] == ':') {
+    *out = ParsedTimezone{};  // UTC unless the zone is found
+    if (tzdbFindZone(tzStr + 1, dbSlot)) {
+      out->db = dbSlot;
+      out->stdOffsetMins = dbSlot->footer.stdOffsetMins;
+      out->dstOffsetMins = dbSlot->footer.dstOffsetMins;
+      out->hasDst = dbSlot->footer.hasDst;
+    } else {
+      DBG_WARN("Zone '%s' not in %s (using UTC)\n", tzStr + 1, TZDB_PATH);
     }
+    return false;
   }
 
-  if (endPtr) *endPtr = str;
-  return true;
-}
-
-// Parse full POSIX TZ string
-void parseTimezoneString(const char* tzStr, ParsedTimezone* tz) {
-  memset(tz, 0, sizeof(ParsedTimezone));
-
-  const char* p = tzStr;
-
-  // Skip STD name (alphabetic characters)
-  while (*p && ((*p >= 'A' && *p <= 'Z') || (*p >= 'a' && *p <= 'z'))) p++;
-
-  // Parse STD offset
-  tz->stdOffsetMins = parseOffset(p, &p);
-
-  // Check for DST
-  if (!*p || *p == '\0') {
-    tz->hasDst = false;
-    tz->dstOffsetMins = tz->stdOffsetMins;
-    return;
-  }
-
-  // Skip DST name
-  while (*p && ((*p >= 'A' && *p <= 'Z') || (*p >= 'a' && *p <= 'z'))) p++;
-
-  // DST offset (optional - defaults to STD + 60 mins)
-  tz->hasDst = true;
-  if (*p == ',' || *p == '\0') {
-    tz->dstOffsetMins = tz->stdOffsetMins + 60;
-  } else {
-    tz->dstOffsetMins = parseOffset(p, &p);
-  }
-
-  // Parse DST start rule
-  if (*p == ',') {
-    p++;
-    parseDstRule(p, &tz->dstStart, &p);
-  }
-
-  // Parse DST end rule
-  if (*p == ',') {
-    p++;
-    parseDstRule(p, &tz->dstEnd, &p);
-  }
-}
-
-// Calculate day of week for a given date (0 = Sunday)
-// Using Zeller-like formula
-static int dayOfWeek(int year, int month, int day) {
-  if (month < 3) {
-    month += 12;
-    year--;
+  int idx = findCatalogTimezone(tzStr);
+  if (idx >= 0) {
+    *out = timezoneCatalog.tz[idx];
+    return true;
   }
-  int k = year % 100;
-  int j = year / 100;
-  int dow = (day + (13 * (month + 1)) / 5 + k + k / 4 + j / 4 - 2 * j) % 7;
-  // Adjust to 0=Sunday
-  dow = (dow + 6) % 7;
-  return dow;
-}
-
-// Get day of month for DST transition
-// rule: M.w.d where w=1-4 means "nth occurrence", w=5 means "last"
-static int getDstTransitionDay(int year, const DstRule* rule) {
-  int month = rule->month;
-  int targetDow = rule->dow;
-  int week = rule->week;
-
-  if (week == 5) {
-    // Last occurrence: start from end of month
-    int daysInMonth[] = {0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
-    // Leap year check
-    if (month == 2 && ((year % 4 == 0 && year % 100 != 0) || year % 400 == 0)) {
-      daysInMonth[2] = 29;
-    }
-    int lastDay = daysInMonth[month];
-    int lastDow = dayOfWeek(year, month, lastDay);
-    int diff = lastDow - targetDow;
-    if (diff < 0) diff += 7;
-    return lastDay - diff;
-  } else {
-    // Nth occurrence: find first occurrence then add weeks
-    int firstDow = dayOfWeek(year, month, 1);
-    int diff = targetDow - firstDow;
-    if (diff < 0) diff += 7;
-    int firstOccurrence = 1 + diff;
-    return firstOccurrence + (week - 1) * 7;
-  }
-}
-
-// Check if DST is active for given UTC time
-static bool isDstActive(time_t utc, const ParsedTimezone* tz) {
-  if (!tz->hasDst) return false;
-
-  // Convert to approximate local time for date calculations
-  // Use standard offset as baseline
-  time_t approxLocal = utc + (tz->stdOffsetMins * 60);
-  struct tm ltm;
-  gmtime_r(&approxLocal, &ltm);
-
-  int year = ltm.tm_year + 1900;
-  int month = ltm.tm_mon + 1;
-  int day = ltm.tm_mday;
-  int hour = ltm.tm_hour;
-
-  // Get transition days for this year
-  int startDay = getDstTransitionDay(year, &tz->dstStart);
-  int endDay = getDstTransitionDay(year, &tz->dstEnd);
-
-  int startMonth = tz->dstStart.month;
-  int endMonth = tz->dstEnd.month;
-  int startHour = tz->dstStart.hour;
-  int endHour = tz->dstEnd.hour;
-
-  // Southern hemisphere: DST spans year boundary (start > end month)
-  bool southernHemisphere = (startMonth > endMonth);
-
-  // Create comparable values: month * 10000 + day * 100 + hour
-  int current = month * 10000 + day * 100 + hour;
-  int start = startMonth * 10000 + startDay * 100 + startHour;
-  int end = endMonth * 10000 + endDay * 100 + endHour;
-
-  if (southernHemisphere) {
-    // DST active from start (e.g., Oct) through end of year, and start of year through end (e.g., Apr)
-    return (current >= start || current < end);
-  } else {
-    // Northern hemisphere: DST active between start and end
-    return (current >= start && current < end);
+  if (!parseTimezoneString(tzStr, out)) {
+    DBG_WARN("Malformed TZ string '%s' (DST ignored)\n", tzStr);
   }
+  return false;
 }
 
-// Get local time from UTC without using setenv() - NO MEMORY LEAK
-void getLocalTimeNoSetenv(time_t utc, const ParsedTimezone* tz, struct tm* out) {
-  int16_t offsetMins = isDstActive(utc, tz) ? tz->dstOffsetMins : tz->stdOffsetMins;
-  time_t local = utc + (offsetMins * 60);
-  gmtime_r(&local, out);
-}
-
-// Parse all configured timezones (call after config load)
+// Resolve all configured timezones (call after config load)
 void parseAllTimezones() {
-  parseTimezoneString(config.homeCityTz, &parsedTz[0]);
-  for (int i = 0; i < 5; i++) {
-    parseTimezoneString(config.remoteTzStrings[i], &parsedTz[i + 1]);
+  int fromCatalog = resolveTimezone(config.homeCityTz, &parsedTz[0], &tzdbZones[0]) ? 1 : 0;
+  for (int i = 0; i < config.remoteCount; i++) {
+    if (resolveTimezone(config.remoteTzStrings[i], &parsedTz[i + 1], &tzdbZones[i + 1])) fromCatalog++;
   }
-  DBG_INFO("Parsed %d timezones (no setenv)\n", 6);
+  int fromTzdb = 0;
+  for (int i = 0; i < cityCount(); i++) {
+    if (parsedTz[i].db != nullptr) fromTzdb++;
+  }
+  DBG_INFO("Resolved %d TZs (%d catalog, %d tzdb, no setenv)\n", cityCount(), fromCatalog, fromTzdb);
 }
 
 // Default configuration
@@ -468,6 +389,9 @@ const char *DEFAULT_REMOTE_TZS[] = {
     "MST7MDT,M3.2.0/2,M11.1.0/2",
     "JST-9"
 };
+// Remote slots beyond the five defaults start as UTC until configured
+const char *DEFAULT_EXTRA_LABEL = "UTC";
+const char *DEFAULT_EXTRA_TZ = "UTC0";
 
 // =========================
 // Configuration Storage (NVS)
@@ -476,6 +400,7 @@ const char *DEFAULT_REMOTE_TZS[] = {
 #define PREF_HOME_LABEL "homeLabel"
 #define PREF_HOME_TZ "homeTz"
 #define PREF_REMOTE_PREFIX "remote"  // remote0Label, remote0Tz, etc.
+#define PREF_REMOTE_COUNT "remoteCnt"  // Remote cities in use
 #define PREF_LANDSCAPE "landscape"   // Display orientation: true = landscape
 #define PREF_FLIP "flip"             // Flip display 180°: true = flipped
 #define PREF_FAHRENHEIT "fahrenheit" // Temperature unit: true = Fahrenheit, false = Celsius
@@ -542,15 +467,17 @@ void loadConfig() {
   DBG_INFO("After strlcpy: config.homeCityLabel='%s'\n", config.homeCityLabel);
   strlcpy(config.homeCityTz, homeTz.c_str(), sizeof(config.homeCityTz));
 
-  // Load 5 remote cities
-  for (int i = 0; i < 5; i++) {
+  // Load remote cities
+  config.remoteCount = prefs.getUChar(PREF_REMOTE_COUNT, MIN_REMOTE_CITIES);
+  config.remoteCount = constrain(config.remoteCount, MIN_REMOTE_CITIES, MAX_REMOTE_CITIES);
+  for (int i = 0; i < config.remoteCount; i++) {
     // FIXED: Use char buffer instead of String to avoid heap allocation in loop
     char labelKey[20];
     char tzKey[20];
     snprintf(labelKey, sizeof(labelKey), "%s%dLabel", PREF_REMOTE_PREFIX, i);
     snprintf(tzKey, sizeof(tzKey), "%s%dTz", PREF_REMOTE_PREFIX, i);
-    String label = prefs.getString(labelKey, DEFAULT_REMOTE_LABELS[i]);
-    String tz = prefs.getString(tzKey, DEFAULT_REMOTE_TZS[i]);
+    String label = prefs.getString(labelKey, i < 5 ? DEFAULT_REMOTE_LABELS[i] : DEFAULT_EXTRA_LABEL);
+    String tz = prefs.getString(tzKey, i < 5 ? DEFAULT_REMOTE_TZS[i] : DEFAULT_EXTRA_TZ);
     char cityBuf[32];
     extractCityName(label.c_str(), cityBuf, sizeof(cityBuf));
     strlcpy(config.remoteCities[i], cityBuf, sizeof(config.remoteCities[i]));
@@ -565,8 +492,10 @@ void loadConfig() {
   config.screenFlipInterval = prefs.getUChar(PREF_FLIP_INTERVAL, 8);       // Default: 8 seconds
 
   prefs.end();
-  DBG_INFO("Config loaded: Home=%s, Remote0=%s, Landscape=%d, Flip=%d, °%s\n",
-           config.homeCityLabel, config.remoteCities[0], config.landscapeMode, config.flipDisplay,
+  // Split so each line fits the 80-byte log buffer with full-length labels
+  DBG_INFO("Config loaded: Home=%s\n", config.homeCityLabel);
+  DBG_INFO("Config: Remote0=%s (%u remotes)\n", config.remoteCities[0], (unsigned)config.remoteCount);
+  DBG_INFO("Config: Landscape=%d, Flip=%d, °%s\n", (int)config.landscapeMode, (int)config.flipDisplay,
            config.useFahrenheit ? "F" : "C");
 }
 
@@ -575,9 +504,20 @@ void saveConfig() {
   prefs.begin(PREF_NAMESPACE, false);
   prefs.putString(PREF_HOME_LABEL, config.homeCityLabel);
   prefs.putString(PREF_HOME_TZ, config.homeCityTz);
-  for (int i = 0; i < 5; i++) {
-    prefs.putString((String(PREF_REMOTE_PREFIX) + i + "Label").c_str(), config.remoteCities[i]);
-    prefs.putString((String(PREF_REMOTE_PREFIX) + i + "Tz").c_str(), config.remoteTzStrings[i]);
+  prefs.putUChar(PREF_REMOTE_COUNT, config.remoteCount);
+  for (int i = 0; i < MAX_REMOTE_CITIES; i++) {
+    char labelKey[20];
+    char tzKey[20];
+    snprintf(labelKey, sizeof(labelKey), "%s%dLabel", PREF_REMOTE_PREFIX, i);
+    snprintf(tzKey, sizeof(tzKey), "%s%dTz", PREF_REMOTE_PREFIX, i);
+    if (i < config.remoteCount) {
+      prefs.putString(labelKey, config.remoteCities[i]);
+      prefs.putString(tzKey, config.remoteTzStrings[i]);
+    } else if (prefs.isKey(labelKey)) {
+      // Slot no longer used: free the NVS entries
+      prefs.remove(labelKey);
+      prefs.remove(tzKey);
+    }
   }
   prefs.putBool(PREF_LANDSCAPE, config.landscapeMode);
   prefs.putBool(PREF_FLIP, config.flipDisplay);
@@ -588,9 +528,17 @@ void saveConfig() {
   DBG_INFO("Config saved\n");
 }
 
+void abortStaticLayout();
+void invalidateLayerCaches();
+void resetPanelScroll();
+void closeDiagnosticsScreen();
+
 // Apply display rotation based on config
 // Rotation values: 0=portrait, 1=landscape, 2=portrait-flipped, 3=landscape-flipped
 void applyRotation() {
+  abortStaticLayout();  // Caller redraws the layout for the new rotation
+  invalidateLayerCaches();
+
   int rotation;
   if (config.landscapeMode) {
     rotation = config.flipDisplay ? 3 : 1;  // Landscape: 1 normal, 3 flipped
@@ -598,6 +546,7 @@ void applyRotation() {
     rotation = config.flipDisplay ? 2 : 0;  // Portrait: 0 normal, 2 flipped
   }
   tft.setRotation(rotation);
+  resetPanelScroll();  // Drop a diagnostics log scroll area
   touchscreen.setRotation(rotation);
   DBG_INFO("Display rotation set to %d (%s%s)\n",
            rotation,
@@ -636,7 +585,6 @@ const uint16_t kHourMarkerColor = TFT_WHITE;
 const uint16_t kHourHandColor = TFT_WHITE;
 const uint16_t kMinuteHandColor = TFT_WHITE;
 const uint16_t kSecondHandColor = TFT_RED;
-const char *kFontHeader = "NotoSans-Bold9";
 const char *kFontLabel = "NotoSans-Bold10";
 const char *kFontTime = "NotoSans-Bold16";
 const char *kFontNote = "NotoSans-Bold7";
@@ -645,161 +593,578 @@ const int kFallbackLabel = 4;
 const int kFallbackTime = 6;
 const int kFallbackNote = 2;
 
+// Glyph cell text (setGlyphCells()): the digits, then the colon. The glyph
+// cache renders these; tools/fonts/vlw2h.py keeps them in each cell font.
+constexpr char kTimeGlyphs[] = "0123456789:";
+
 // Forward declarations
 void takeScreenshot();
 void takeScreenshotRaw();
 void drawEnvironmentalData();
+void finishStaticLayout();
+void invalidateWidgets();
+void invalidateClocks();
 
-// Cached state to minimize redraws and flicker.
-// Use fixed char arrays instead of String to avoid heap fragmentation
-char lastDate[16];
-char lastTimes[6][8];  // 6 cities: home + 5 remote, "HH:MM" format
-bool lastPrevDay[6];
-bool lastNextDay[6];
-bool lastColonState[6];
-int timePadWidth = 0;
 unsigned long lastDebugPrint = 0;
-bool smoothFontsReady = false;
+bool littleFsReady = false;
 const char *currentSmoothFont = nullptr;
 
-// Analog clock state (for selective redraw)
-int lastSecond = -1;
-int lastMinute = -1;
-int lastHour = -1;
+// Remote city paging: each layout shows REMOTE_ROWS_PER_PAGE remote rows, so
+// the per-second cost depends on the rows on screen, not on remoteCount.
+static uint8_t remotePage = 0;
+static time_t lastPageFlip = 0;
+
+int remotePageCount() {
+  return (config.remoteCount + REMOTE_ROWS_PER_PAGE - 1) / REMOTE_ROWS_PER_PAGE;
+}
+
+// City index (1..remoteCount) shown in remote row 0..REMOTE_ROWS_PER_PAGE-1
+// of the current page, or -1 if the row is empty (last page)
+int cityForRemoteRow(int row) {
+  int remote = remotePage * REMOTE_ROWS_PER_PAGE + row;
+  return (remote < config.remoteCount) ? remote + 1 : -1;
+}
+
 
 // NOTE: Old getLocalTm() function removed - it used setenv() which leaks memory
 // Now using getLocalTimeNoSetenv() with manual TZ calculation instead
 
-// Switch between smooth fonts (loaded from SPIFFS) or fallback bitmap fonts.
-// Optimized to avoid heap allocations - uses stack buffer for path construction.
-void setFont(const char *smoothFontName, int fallbackFont) {
-  if (kUseSmoothFonts && smoothFontsReady) {
+// Smooth font loads since boot (flash or LittleFS) and the time they took
+uint32_t fontLoads = 0;
+uint32_t fontLoadMicros = 0;
+uint32_t fontLoadLastUs = 0;
+
+// Font compiled into the firmware (include/fonts_vlw.h), or nullptr
+static const uint8_t *compiledFont(const char *name) {
+  for (size_t i = 0; i < kCompiledFontCount; i++) {
+    if (strcmp(kCompiledFonts[i].name, name) == 0) {
+      return kCompiledFonts[i].data;
+    }
+  }
+  return nullptr;
+}
+
+// Switch gfx (the panel or a sprite) between a smooth font and a fallback
+// bitmap font. Smooth fonts come from the arrays compiled in by
+// tools/fonts/vlw2h.py; one missing there is loaded from LittleFS.
+// loadedFont tracks the smooth font gfx has loaded, so repeated calls with
+// the same font cost nothing. smoothFontName == nullptr selects the bitmap font.
+void setFontOn(TFT_eSPI &gfx, const char *&loadedFont, const char *smoothFontName, int fallbackFont) {
+  if (smoothFontName != nullptr && kUseSmoothFonts) {
     // Only reload if font actually changed (pointer comparison is intentional
     // since we use string literals for font names)
-    if (currentSmoothFont != smoothFontName) {
-      // Safely unload previous font if one was loaded
-      if (currentSmoothFont != nullptr) {
-        tft.unloadFont();
-        currentSmoothFont = nullptr;
-      }
+    if (loadedFont == smoothFontName) {
+      return;
+    }
+    fontSwitches++;
+    // Safely unload previous font if one was loaded
+    if (loadedFont != nullptr) {
+      gfx.unloadFont();
+      loadedFont = nullptr;
+    }
+
+    uint32_t start = micros();
+    const uint8_t *data = compiledFont(smoothFontName);
+    if (data != nullptr) {
+      gfx.loadFont(data);  // Metrics parsed from flash, no file I/O
+      loadedFont = smoothFontName;
+    } else if (littleFsReady) {
       // Use stack buffer instead of String to avoid heap fragmentation
       char path[48];
       snprintf(path, sizeof(path), "/%s.vlw", smoothFontName);
       if (LittleFS.exists(path)) {
-        tft.loadFont(smoothFontName, LittleFS);
-        currentSmoothFont = smoothFontName;
-        return;
+        gfx.loadFont(smoothFontName, LittleFS);
+        loadedFont = smoothFontName;
       }
-      // If smooth font failed to load, fall through to bitmap font
-    } else if (currentSmoothFont != nullptr) {
-      // Font already loaded and valid, nothing to do
+    }
+    if (loadedFont != nullptr) {
+      fontLoadLastUs = micros() - start;
+      fontLoadMicros += fontLoadLastUs;
+      fontLoads++;
+      renderTimers[RT_FONT_LOAD].record(fontLoadLastUs);
       return;
     }
-    // If we get here, either smooth font failed or currentSmoothFont is null
+    // If we get here the smooth font is unavailable: use the bitmap font
   }
   // Use bitmap font as fallback
-  currentSmoothFont = nullptr;
-  tft.setTextFont(fallbackFont);
+  if (loadedFont != nullptr) {
+    gfx.unloadFont();
+    loadedFont = nullptr;
+    fontSwitches++;
+  }
+  gfx.setTextFont(fallbackFont);
+}
+
+// Panel font (see setFontOn)
+void setFont(const char *smoothFontName, int fallbackFont) {
+  setFontOn(tft, currentSmoothFont, smoothFontName, fallbackFont);
 }
 
 // =========================
-// Analog Clock Drawing (Landscape Mode)
+// Analog Clock Widget
 // =========================
+// One AnalogClock per screen that shows one (landscape left panel, alternate
+// portrait top-left). The static layout paints the face; each update
+// redraws only the hands whose table position changed:
+//   1. erase the changed hands (background colour)
+//   2. inside each erased hand's bounding box, restore the face pixels from
+//      a 1-bit mask of the face and redraw the unchanged hands (clipped)
+//   3. draw the changed hands at their new position, then the centre cap
+// The mask (two 1-bpp sprites of the face square: "face pixel" and "marker
+// colour") is built once for the clock on screen, ~3 KB. A thin hand only
+// restores the face along its own line, so a sweeping second hand
+// (CLOCK_SWEEP_ENABLED) repaints just the pixels it crossed.
+
+enum ClockHand : uint8_t { HAND_HOUR, HAND_MINUTE, HAND_SECOND, HAND_COUNT };
+
+// Half-open screen rectangle [x0, x1) x [y0, y1)
+struct ClockRect {
+  int16_t x0, y0, x1, y1;
+};
+
+struct AnalogClock {
+  int16_t cx, cy, radius;
+  int16_t handLen[HAND_COUNT];     // Hour, minute, second
+  uint16_t handColor[HAND_COUNT];
+  uint16_t faceColor;              // Circle (and minor markers unless minorBright)
+  uint16_t markerColor;            // 12/3/6/9 markers and centre cap
+  bool minorBright;                // Minor markers in markerColor
+  bool markersDown;                // Major markers doubled a pixel down (else right)
+  int16_t shown[HAND_COUNT];       // Table position on screen, -1 = not drawn
+};
+
+const uint8_t kHandThickness[HAND_COUNT] = {3, 2, 1};
+
+// Frames between second ticks: sweep hand, or sprite frame rate
+#define CLOCK_FRAMES_ENABLED (CLOCK_SPRITE_ENABLED || CLOCK_SWEEP_ENABLED)
+#if CLOCK_SWEEP_ENABLED
+static_assert(CLOCK_SWEEP_FPS >= 10 && CLOCK_SWEEP_FPS <= CLOCK_SWEEP_STEPS, "CLOCK_SWEEP_FPS must be 10-30");
+const uint32_t kClockFrameUs = 1000000 / CLOCK_SWEEP_FPS;
+#else
+const uint32_t kClockFrameUs = 1000000 / CLOCK_SPRITE_FPS;
+#endif
+
+AnalogClock landscapeClock = {
+  kClockCenterX, kClockCenterY, kClockRadius,
+  {kHourHandLen, kMinuteHandLen, kSecondHandLen},
+  {kHourHandColor, kMinuteHandColor, kSecondHandColor},
+  kClockFaceColor, kHourMarkerColor, false, false,
+  {-1, -1, -1}
+};
+
+// Alternate portrait: top-left, flush to the left edge, bottom at y=135
+AnalogClock alternateClock = {
+  60, 80, 55,
+  {28, 40, 45},
+  {TFT_WHITE, TFT_WHITE, TFT_RED},
+  TFT_DARKGREY, TFT_WHITE, true, true,
+  {-1, -1, -1}
+};
+
+TFT_eSprite clockFaceMask(&tft);    // Face pixel at (x, y) of the face square
+TFT_eSprite clockMarkerMask(&tft);  // ...drawn in markerColor
+const AnalogClock *maskClock = nullptr;
+uint32_t clockRestoredPixels = 0;   // Face pixels restored under erased hands
+
+// Hand update cost per second tick (erase + redraw), both clock screens
+uint32_t handTicks = 0;
+uint32_t handTickTotalUs = 0;
+uint32_t handTickLastUs = 0;
+uint32_t handTickMaxUs = 0;
+
+// Frames drawn and time spent in the current / last wall-clock second
+uint32_t clockWindowFrames = 0;
+uint32_t clockWindowUs = 0;
+uint32_t clockFps = 0;
+uint32_t clockCpuUs = 0;  // Clock drawing time per second
+
+static void recordClockFrame(uint32_t us) {
+  clockWindowFrames++;
+  clockWindowUs += us;
+  renderTimers[RT_CLOCK_HANDS].record(us);
+}
 
-// Draw a clock hand from center to endpoint
-// Uses line drawing - erases by drawing in background color
-void drawClockHand(int cx, int cy, int length, float angleDeg, uint16_t color, int thickness = 1) {
-  // Convert angle to radians (0 = 12 o'clock, clockwise)
-  float angleRad = (angleDeg - 90.0f) * PI / 180.0f;
-  int x2 = cx + (int)(length * cos(angleRad));
-  int y2 = cy + (int)(length * sin(angleRad));
+static void recordHandTick(uint32_t startUs) {
+  handTickLastUs = micros() - startUs;
+  handTickTotalUs += handTickLastUs;
+  if (handTickLastUs > handTickMaxUs) handTickMaxUs = handTickLastUs;
+  handTicks++;
+  recordClockFrame(handTickLastUs);
+}
 
+// Draw a clock hand from center along dir (clock_geometry.h tables):
+// a line when thin, else one filled triangle tapering to the tip.
+// Erases by drawing in background color (same pixels).
+void drawClockHand(int cx, int cy, int length, const ClockDir &dir, uint16_t color, int thickness = 1) {
   if (thickness <= 1) {
+    int x2, y2;
+    clockPoint(cx, cy, dir, length, &x2, &y2);
     tft.drawLine(cx, cy, x2, y2, color);
   } else {
-    // Draw thicker hand using multiple parallel lines
-    for (int i = -thickness/2; i <= thickness/2; i++) {
-      int offsetX = (int)(i * sin(angleRad));
-      int offsetY = (int)(-i * cos(angleRad));
-      tft.drawLine(cx + offsetX, cy + offsetY, x2 + offsetX, y2 + offsetY, color);
-    }
+    int x0, y0, x1, y1, x2, y2;
+    clockHandTriangle(cx, cy, dir, length, thickness, &x0, &y0, &x1, &y1, &x2, &y2);
+    tft.fillTriangle(x0, y0, x1, y1, x2, y2, color);
   }
 }
 
-// Draw the static analog clock face (circle + hour markers)
-void drawAnalogClockFace() {
-  // Draw clock face circle
-  tft.drawCircle(kClockCenterX, kClockCenterY, kClockRadius, kClockFaceColor);
+static const ClockDir &handDir(int hand, int pos) {
+  if (hand == HAND_HOUR) return kHourDirs[pos];
+  if (CLOCK_SWEEP_ENABLED && hand == HAND_SECOND) return kSweepDirs[pos];
+  return kMinuteDirs[pos];
+}
 
-  // Draw hour markers (12 positions)
-  for (int i = 0; i < 12; i++) {
-    float angleDeg = i * 30.0f;  // 360/12 = 30 degrees per hour
-    float angleRad = (angleDeg - 90.0f) * PI / 180.0f;
+static void drawHand(const AnalogClock &clock, int hand, int pos, uint16_t color) {
+  drawClockHand(clock.cx, clock.cy, clock.handLen[hand], handDir(hand, pos), color, kHandThickness[hand]);
+}
 
-    // Inner and outer positions for marker
-    int outerR = kClockRadius - 3;
-    int innerR = kClockRadius - 8;
+// Screen rectangle [x0, x1) x [y0, y1) covered by a hand
+static ClockRect handBounds(const AnalogClock &clock, int hand, int pos) {
+  int x0, y0, x1, y1, x2, y2;
+  clockHandTriangle(clock.cx, clock.cy, handDir(hand, pos), clock.handLen[hand],
+                    kHandThickness[hand], &x0, &y0, &x1, &y1, &x2, &y2);
+  if (kHandThickness[hand] <= 1) {
+    x0 = x1 = clock.cx;
+    y0 = y1 = clock.cy;
+  }
+  return {(int16_t)min(min(x0, x1), x2), (int16_t)min(min(y0, y1), y2),
+          (int16_t)(max(max(x0, x1), x2) + 1), (int16_t)(max(max(y0, y1), y2) + 1)};
+}
 
-    int x1 = kClockCenterX + (int)(innerR * cos(angleRad));
-    int y1 = kClockCenterY + (int)(innerR * sin(angleRad));
-    int x2 = kClockCenterX + (int)(outerR * cos(angleRad));
-    int y2 = kClockCenterY + (int)(outerR * sin(angleRad));
+// Face of a clock centred at (cx, cy) in the given colours
+static void drawClockFaceAt(TFT_eSPI &gfx, const AnalogClock &clock, int cx, int cy,
+                            uint16_t faceColor, uint16_t minorColor, uint16_t markerColor) {
+  gfx.drawCircle(cx, cy, clock.radius, faceColor);
+
+  // Hour markers (12 positions, every 5th minute direction)
+  for (int i = 0; i < 12; i++) {
+    int x1, y1, x2, y2;
+    clockPoint(cx, cy, kMinuteDirs[i * 5], clock.radius - 8, &x1, &y1);
+    clockPoint(cx, cy, kMinuteDirs[i * 5], clock.radius - 3, &x2, &y2);
 
-    // Draw marker (thicker at 12, 3, 6, 9)
     if (i % 3 == 0) {
-      tft.drawLine(x1, y1, x2, y2, kHourMarkerColor);
-      tft.drawLine(x1+1, y1, x2+1, y2, kHourMarkerColor);
+      // 12, 3, 6, 9: drawn twice, a pixel apart
+      int dx = clock.markersDown ? 0 : 1;
+      gfx.drawLine(x1, y1, x2, y2, markerColor);
+      gfx.drawLine(x1 + dx, y1 + 1 - dx, x2 + dx, y2 + 1 - dx, markerColor);
     } else {
-      tft.drawLine(x1, y1, x2, y2, kClockFaceColor);
+      gfx.drawLine(x1, y1, x2, y2, minorColor);
+    }
+  }
+
+  // Centre cap
+  gfx.fillCircle(cx, cy, 3, markerColor);
+}
+
+// Static face (circle, markers, centre cap) into the panel or a band sprite
+void drawClockFace(TFT_eSPI &gfx, const AnalogClock &clock) {
+  drawClockFaceAt(gfx, clock, clock.cx, clock.cy, clock.faceColor,
+                  clock.minorBright ? clock.markerColor : clock.faceColor, clock.markerColor);
+}
+
+// Render the face of clock into the two 1-bpp masks
+static bool buildClockFaceMask(const AnalogClock &clock) {
+  maskClock = nullptr;
+  int size = 2 * clock.radius + 1;
+  TFT_eSprite *planes[2] = {&clockFaceMask, &clockMarkerMask};
+  for (TFT_eSprite *plane : planes) {
+    plane->deleteSprite();
+    plane->setColorDepth(1);
+    if (plane->createSprite(size, size) == nullptr) {
+      DBG_WARN("Clock face mask %dx%d failed, erased hands leave gaps\n", size, size);
+      return false;
+    }
+    plane->setBitmapColor(1, 0);  // readPixel() returns 1 for a set pixel
+    plane->fillSprite(0);
+  }
+
+  int c = clock.radius;
+  drawClockFaceAt(clockFaceMask, clock, c, c, 1, 1, 1);
+  drawClockFaceAt(clockMarkerMask, clock, c, c, 0, clock.minorBright ? 1 : 0, 1);
+  maskClock = &clock;
+  return true;
+}
+
+// Redraw the face pixels of screen row y in [x0, x1): one address window
+// per run of adjacent face pixels, one pushColor() per colour within it
+static void restoreFaceRow(const AnalogClock &clock, int y, int x0, int x1) {
+  int left = clock.cx - clock.radius;
+  int my = y - (clock.cy - clock.radius);
+  int size = 2 * clock.radius + 1;
+  if (my < 0 || my >= size) return;
+  x0 = max(x0, left);
+  x1 = min(x1, left + size);
+  int x = x0;
+  while (x < x1) {
+    if (clockFaceMask.readPixel(x - left, my) == 0) {
+      x++;
+      continue;
+    }
+    int end = x + 1;
+    while (end < x1 && clockFaceMask.readPixel(end - left, my) != 0) end++;
+    tft.setAddrWindow(x, y, end - x, 1);
+    clockRestoredPixels += end - x;
+    while (x < end) {
+      bool marker = clockMarkerMask.readPixel(x - left, my) != 0;
+      int n = 1;
+      while (x + n < end && (clockMarkerMask.readPixel(x + n - left, my) != 0) == marker) n++;
+      tft.pushColor(marker ? clock.markerColor : clock.faceColor, n);
+      x += n;
+    }
+  }
+}
+
+// Redraw the face pixels inside r (after hands were erased there)
+static void restoreClockFace(const AnalogClock &clock, const ClockRect &r) {
+  if (maskClock != &clock) return;
+  tft.startWrite();
+  for (int y = r.y0; y < r.y1; y++) {
+    restoreFaceRow(clock, y, r.x0, r.x1);
+  }
+  tft.endWrite();
+}
+
+// Rows a thin hand's line touches, merged into one span each before they
+// are restored. The line is monotonic, so at most three rows are open at a
+// time; the one farthest from a newly touched row is finished.
+struct FaceRowSpan {
+  int y, x0, x1;  // [x0, x1)
+};
+
+static void touchFaceRow(const AnalogClock &clock, FaceRowSpan *open, int &count, int y, int x) {
+  for (int i = 0; i < count; i++) {
+    if (open[i].y == y) {
+      open[i].x0 = min(open[i].x0, x);
+      open[i].x1 = max(open[i].x1, x + 1);
+      return;
+    }
+  }
+  if (count == 3) {
+    int far = 0;
+    for (int i = 1; i < count; i++) {
+      if (abs(open[i].y - y) > abs(open[far].y - y)) far = i;
+    }
+    restoreFaceRow(clock, open[far].y, open[far].x0, open[far].x1);
+    open[far] = open[--count];
+  }
+  open[count++] = {y, x, x + 1};
+}
+
+// Redraw the face pixels a thin hand's line crossed: one step per pixel
+// along the major axis, plus the neighbours either side on the minor axis
+// (covers the line rasteriser's rounding)
+static void restoreClockFaceAlong(const AnalogClock &clock, int hand, int pos) {
+  if (maskClock != &clock) return;
+  int x2, y2;
+  clockPoint(clock.cx, clock.cy, handDir(hand, pos), clock.handLen[hand], &x2, &y2);
+  int dx = x2 - clock.cx;
+  int dy = y2 - clock.cy;
+  int steps = max(abs(dx), abs(dy));
+  bool xMajor = abs(dx) >= abs(dy);
+  FaceRowSpan open[3];
+  int count = 0;
+  tft.startWrite();
+  for (int i = 0; i <= steps; i++) {
+    int x = clock.cx + (steps ? (dx * i + (dx >= 0 ? steps : -steps) / 2) / steps : 0);
+    int y = clock.cy + (steps ? (dy * i + (dy >= 0 ? steps : -steps) / 2) / steps : 0);
+    for (int d = -1; d <= 1; d++) {
+      touchFaceRow(clock, open, count, xMajor ? y + d : y, xMajor ? x : x + d);
+    }
+  }
+  for (int i = 0; i < count; i++) {
+    restoreFaceRow(clock, open[i].y, open[i].x0, open[i].x1);
+  }
+  tft.endWrite();
+}
+
+static bool rectsOverlap(const ClockRect &a, const ClockRect &b) {
+  return a.x0 < b.x1 && b.x0 < a.x1 && a.y0 < b.y1 && b.y0 < a.y1;
+}
+
+// -------------------------
+// Anti-aliased sprite rendering (CLOCK_SPRITE_ENABLED)
+// -------------------------
+// The whole disc is redrawn each frame in a sprite, so hands can be
+// anti-aliased and overlap without an erase pass, then pushed as one window.
+
+#if CLOCK_SPRITE_ENABLED
+static_assert(CLOCK_SPRITE_FPS >= 1 && CLOCK_SPRITE_FPS <= 30, "CLOCK_SPRITE_FPS must be 1-30");
+#endif
+TFT_eSprite clockSprite(&tft);
+const AnalogClock *clockSpriteFor = nullptr;     // Clock the buffer is sized for
+const AnalogClock *clockSpriteFailed = nullptr;  // Allocation failed for this clock
+
+// Frame cost: render into the sprite, then push to the panel
+uint32_t clockFrames = 0;
+uint32_t clockRenderLastUs = 0;
+uint32_t clockRenderTotalUs = 0;
+uint32_t clockPushLastUs = 0;
+uint32_t clockPushTotalUs = 0;
+uint32_t clockFrameMaxUs = 0;
+uint32_t clockSpriteFallbacks = 0;  // Frames drawn directly (no buffer)
+
+#if CLOCK_SPRITE_ENABLED
+// Render clock with hands at table positions pos into the sprite and push it.
+// Returns false if the sprite can't be allocated.
+static bool renderClockSprite(const AnalogClock &clock, const int16_t pos[HAND_COUNT]) {
+  int size = 2 * clock.radius + 1;
+  if (clockSpriteFor != &clock) {
+    if (clockSpriteFailed == &clock) {
+      clockSpriteFallbacks++;
+      return false;
     }
+    clockSprite.deleteSprite();
+    clockSpriteFor = nullptr;
+    clockSprite.setColorDepth(16);
+    if (clockSprite.createSprite(size, size) == nullptr) {
+      DBG_WARN("Clock sprite %dx%d failed (heap %u), drawing directly\n", size, size, ESP.getFreeHeap());
+      clockSpriteFailed = &clock;
+      clockSpriteFallbacks++;
+      return false;
+    }
+    clockSpriteFor = &clock;
+  }
+
+  uint32_t start = micros();
+  const float c = clock.radius;
+  TFT_eSprite &spr = clockSprite;
+  spr.fillSprite(COLOR_BG);
+
+  // Face: anti-aliased ring inside the square, wide-line markers
+  spr.drawSmoothCircle(clock.radius, clock.radius, clock.radius - 1, clock.faceColor, COLOR_BG);
+  for (int i = 0; i < 12; i++) {
+    const ClockDir &dir = kMinuteDirs[i * 5];
+    float dx = dir.x / (float)(1 << CLOCK_Q);
+    float dy = dir.y / (float)(1 << CLOCK_Q);
+    bool major = (i % 3 == 0);
+    uint16_t color = (major || clock.minorBright) ? clock.markerColor : clock.faceColor;
+    spr.drawWideLine(c + dx * (clock.radius - 8), c + dy * (clock.radius - 8),
+                     c + dx * (clock.radius - 3), c + dy * (clock.radius - 3),
+                     major ? 2.5f : 1.5f, color);
+  }
+
+  // Hands: tapered wedges blended over whatever is below (no bg colour)
+  const float baseWidth[HAND_COUNT] = {5.0f, 3.5f, 1.8f};
+  for (int h = 0; h < HAND_COUNT; h++) {
+    const ClockDir &dir = handDir(h, pos[h]);
+    float len = clock.handLen[h];
+    spr.drawWedgeLine(c, c, c + dir.x * len / (1 << CLOCK_Q), c + dir.y * len / (1 << CLOCK_Q),
+                      baseWidth[h], 1.0f, clock.handColor[h]);
   }
+  spr.fillSmoothCircle(clock.radius, clock.radius, 3, clock.markerColor);
+  uint32_t rendered = micros();
+
+  spr.pushSprite(clock.cx - clock.radius, clock.cy - clock.radius);
+  uint32_t pushed = micros();
+
+  clockRenderLastUs = rendered - start;
+  clockPushLastUs = pushed - rendered;
+  clockRenderTotalUs += clockRenderLastUs;
+  clockPushTotalUs += clockPushLastUs;
+  if (pushed - start > clockFrameMaxUs) clockFrameMaxUs = pushed - start;
+  clockFrames++;
+  recordClockFrame(pushed - start);
+  return true;
+}
+#endif
 
-  // Draw center dot
-  tft.fillCircle(kClockCenterX, kClockCenterY, 3, kHourMarkerColor);
+// Hands drawn on screen are unknown after a static repaint
+void invalidateClocks() {
+  for (AnalogClock *clock : {&landscapeClock, &alternateClock}) {
+    for (int h = 0; h < HAND_COUNT; h++) {
+      clock->shown[h] = -1;
+    }
+  }
 }
 
-// Update analog clock hands (selective redraw for flicker-free animation)
-void updateAnalogClockHands(int hour, int minute, int second) {
-  // Calculate angles
-  // Hour: 30 degrees per hour + 0.5 degrees per minute
-  float hourAngle = (hour % 12) * 30.0f + minute * 0.5f;
-  // Minute: 6 degrees per minute
-  float minuteAngle = minute * 6.0f;
-  // Second: 6 degrees per second
-  float secondAngle = second * 6.0f;
+// Move the hands of a clock to hour:minute:second (+ ms into the second for
+// the sweep hand), redrawing only what moved
+void updateClock(AnalogClock &clock, int hour, int minute, int second, int ms) {
+  const int16_t want[HAND_COUNT] = {
+    (int16_t)clockHourPos(hour, minute), (int16_t)minute,
+    (int16_t)(CLOCK_SWEEP_ENABLED ? clockSweepPos(second, ms) : second)
+  };
+  bool changed[HAND_COUNT];
+  bool any = false;
+  for (int h = 0; h < HAND_COUNT; h++) {
+    changed[h] = clock.shown[h] != want[h];
+    any = any || changed[h];
+  }
+  if (!any) return;
+#if CLOCK_SPRITE_ENABLED
+  // Whole disc per frame; on failure fall through to the direct path
+  if (renderClockSprite(clock, want)) {
+    for (int h = 0; h < HAND_COUNT; h++) {
+      clock.shown[h] = want[h];
+    }
+    return;
+  }
+#endif
+
+  uint32_t start = micros();
+  if (maskClock != &clock) {
+    buildClockFaceMask(clock);
+  }
 
-  // Erase old hands if they've changed (draw in background color)
-  // Order matters: erase in reverse order of drawing (second, minute, hour)
-  if (lastSecond >= 0 && lastSecond != second) {
-    float oldSecondAngle = lastSecond * 6.0f;
-    drawClockHand(kClockCenterX, kClockCenterY, kSecondHandLen, oldSecondAngle, COLOR_BG, 1);
+  // 1. Erase changed hands, top first
+  ClockRect erased[HAND_COUNT];
+  bool erasedThin[HAND_COUNT];
+  int erasedCount = 0;
+  for (int h = HAND_COUNT - 1; h >= 0; h--) {
+    if (!changed[h] || clock.shown[h] < 0) continue;
+    drawHand(clock, h, clock.shown[h], COLOR_BG);
+    erasedThin[erasedCount] = kHandThickness[h] <= 1;
+    if (erasedThin[erasedCount]) {
+      restoreClockFaceAlong(clock, h, clock.shown[h]);
+    }
+    erased[erasedCount++] = handBounds(clock, h, clock.shown[h]);
+    clock.shown[h] = -1;
   }
-  if (lastMinute >= 0 && lastMinute != minute) {
-    float oldMinuteAngle = lastMinute * 6.0f;
-    drawClockHand(kClockCenterX, kClockCenterY, kMinuteHandLen, oldMinuteAngle, COLOR_BG, 2);
-    // Also need to erase hour hand since it moves with minutes
-    float oldHourAngle = (lastHour % 12) * 30.0f + lastMinute * 0.5f;
-    drawClockHand(kClockCenterX, kClockCenterY, kHourHandLen, oldHourAngle, COLOR_BG, 3);
+
+  // 2. Repair what the erase cut into: face (thin hands did it above), then
+  //    unchanged hands overlapping the erased box (clipped)
+  for (int e = 0; e < erasedCount; e++) {
+    const ClockRect &r = erased[e];
+    if (!erasedThin[e]) restoreClockFace(clock, r);
+    tft.setViewport(r.x0, r.y0, r.x1 - r.x0, r.y1 - r.y0, false);
+    for (int h = 0; h < HAND_COUNT; h++) {
+      if (clock.shown[h] >= 0 && rectsOverlap(r, handBounds(clock, h, clock.shown[h]))) {
+        drawHand(clock, h, clock.shown[h], clock.handColor[h]);
+      }
+    }
+    tft.resetViewport();
   }
 
-  // Draw new hands (order: hour, minute, second - so second is on top)
-  if (lastMinute != minute || lastHour != hour) {
-    drawClockHand(kClockCenterX, kClockCenterY, kHourHandLen, hourAngle, kHourHandColor, 3);
-    drawClockHand(kClockCenterX, kClockCenterY, kMinuteHandLen, minuteAngle, kMinuteHandColor, 2);
+  // 3. New positions, bottom first; unchanged hands above stay on top
+  for (int h = 0; h < HAND_COUNT; h++) {
+    if (!changed[h]) continue;
+    drawHand(clock, h, want[h], clock.handColor[h]);
+    clock.shown[h] = want[h];
+    ClockRect r = handBounds(clock, h, want[h]);
+    tft.setViewport(r.x0, r.y0, r.x1 - r.x0, r.y1 - r.y0, false);
+    for (int above = h + 1; above < HAND_COUNT; above++) {
+      if (!changed[above] && clock.shown[above] >= 0) {
+        drawHand(clock, above, clock.shown[above], clock.handColor[above]);
+      }
+    }
+    tft.resetViewport();
   }
-  drawClockHand(kClockCenterX, kClockCenterY, kSecondHandLen, secondAngle, kSecondHandColor, 1);
 
-  // Redraw center dot (may have been partially erased)
-  tft.fillCircle(kClockCenterX, kClockCenterY, 3, kHourMarkerColor);
+  // Centre cap over the hands
+  tft.fillCircle(clock.cx, clock.cy, 3, clock.markerColor);
+  recordHandTick(start);
+}
 
-  // Update state
-  lastSecond = second;
-  lastMinute = minute;
-  lastHour = hour;
+// Hands at the current home time
+void updateClockNow(AnalogClock &clock) {
+  WallTime now = wallNow();
+  struct tm homeTm;
+  getLocalTimeNoSetenv(now.sec, &parsedTz[0], &homeTm);
+  updateClock(clock, homeTm.tm_hour, homeTm.tm_min, homeTm.tm_sec, now.us / 1000);
 }
 
 // Block until NTP has set a valid time (returns false on timeout).
 bool syncTime() {
+  sntp_set_time_sync_notification_cb(onNtpSync);
   configTzTime(config.homeCityTz, "pool.ntp.org", "time.nist.gov");
   struct tm timeinfo;
   for (int i = 0; i < 20; ++i) {
@@ -991,9 +1356,9 @@ bool updateSensorData() {
   return true;
 }
 
-// Optional: list files on LittleFS to confirm fonts are present.
+// Optional: list files on LittleFS (web UI, extra fonts, tzdb).
 void logLittleFSContents() {
-  if (!smoothFontsReady) {
+  if (!littleFsReady) {
     return;
   }
   File root = LittleFS.open("/");
@@ -1009,210 +1374,577 @@ void logLittleFSContents() {
   }
 }
 
-// Format a date string for home city (e.g., "THU 24 MAR").
-// Writes directly to provided buffer to avoid heap allocation.
-// Uses manual TZ calculation - NO setenv() calls, NO memory leak!
-void formatDate(char *outBuf, size_t bufSize) {
-  time_t now = time(nullptr);
-  struct tm timeinfo;
-  getLocalTimeNoSetenv(now, &parsedTz[0], &timeinfo);  // Always use home city
-  strftime(outBuf, bufSize, "%a %d %b", &timeinfo);
-  // Convert to uppercase in place
-  for (char *p = outBuf; *p; ++p) {
-    *p = toupper((unsigned char)*p);
-  }
-}
-
-struct TimeInfo {
-  char timeStr[8];  // "HH:MM" + null terminator - fixed size to avoid heap allocation
-  bool prevDay;
-  bool nextDay;
-  bool showColon;
+// Per-city cache, refreshed once per minute by updateAllCityTimes().
+// Struct-of-arrays indexed by city (0 = home): the batch update streams
+// through each field contiguously, whatever the city count.
+struct CityTimeCache {
+  LocalTime lt[MAX_CITIES];
+  char timeStr[MAX_CITIES][6];  // "HH:MM"
+  bool prevDay[MAX_CITIES];
+  bool nextDay[MAX_CITIES];
 };
 
-// CRITICAL FIX v2: Batch all timezone updates to minimize setenv() calls
-// setenv("TZ") leaks ~30-40 bytes per call on ESP32
-// By batching updates, we reduce from 6 calls/minute to 1 call/minute
-struct CachedTimeInfo {
-  struct tm tm;
-  char timeStr[8];
-  bool prevDay;
-  bool nextDay;
-};
-
-static CachedTimeInfo timeCache[6];  // Cache for all 6 cities (home + 5 remote)
+static CityTimeCache timeCache;
 static time_t lastBatchUpdate = 0;   // Last time we updated ALL cities
 static bool timeCacheInitialized = false;
 
 // Update all city times in a single batch - called once per minute
-// Uses manual TZ calculation - NO setenv() calls, NO memory leak!
+// One UTC read, one integer civil-time pass over all cities (no gmtime_r,
+// no setenv), then prev/next day flags relative to home.
 void updateAllCityTimes() {
   time_t now = time(nullptr);
 
-  // Get home city time first (needed for prevDay/nextDay comparison)
-  getLocalTimeNoSetenv(now, &parsedTz[0], &timeCache[0].tm);
-  snprintf(timeCache[0].timeStr, sizeof(timeCache[0].timeStr),
-           "%02d:%02d", timeCache[0].tm.tm_hour, timeCache[0].tm.tm_min);
-  timeCache[0].prevDay = false;  // Home is never "previous day" relative to itself
-  timeCache[0].nextDay = false;  // Home is never "next day" relative to itself
+  const int count = cityCount();
+  utcToLocalBatch(now, parsedTz, timeCache.lt, count);
 
-  // Update remote cities
-  for (int i = 0; i < 5; i++) {
-    getLocalTimeNoSetenv(now, &parsedTz[i + 1], &timeCache[i + 1].tm);
-    snprintf(timeCache[i + 1].timeStr, sizeof(timeCache[i + 1].timeStr),
-             "%02d:%02d", timeCache[i + 1].tm.tm_hour, timeCache[i + 1].tm.tm_min);
-
-    // Check if remote city is in previous day relative to home
-    timeCache[i + 1].prevDay = false;
-    timeCache[i + 1].nextDay = false;
-    if (timeCache[i + 1].tm.tm_year < timeCache[0].tm.tm_year) {
-      timeCache[i + 1].prevDay = true;
-    } else if (timeCache[i + 1].tm.tm_year == timeCache[0].tm.tm_year &&
-               timeCache[i + 1].tm.tm_yday < timeCache[0].tm.tm_yday) {
-      timeCache[i + 1].prevDay = true;
-    }
-    // Check if remote city is in next day relative to home
-    if (timeCache[i + 1].tm.tm_year > timeCache[0].tm.tm_year) {
-      timeCache[i + 1].nextDay = true;
-    } else if (timeCache[i + 1].tm.tm_year == timeCache[0].tm.tm_year &&
-               timeCache[i + 1].tm.tm_yday > timeCache[0].tm.tm_yday) {
-      timeCache[i + 1].nextDay = true;
-    }
+  for (int i = 0; i < count; i++) {
+    formatTimeHHMM(&timeCache.lt[i], timeCache.timeStr[i]);
+  }
+  for (int i = 0; i < count; i++) {
+    // Home (i == 0) compares equal to itself, so never prev/next day
+    int dayDiff = compareLocalDate(&timeCache.lt[i], &timeCache.lt[0]);
+    timeCache.prevDay[i] = (dayDiff < 0);
+    timeCache.nextDay[i] = (dayDiff > 0);
   }
-
-  // No setenv() restore needed - we don't use setenv() anymore!
 
   lastBatchUpdate = now;
   timeCacheInitialized = true;
 }
 
-// Build time string plus flags used by the renderer.
-// Uses cached values - only updates when minute changes via batch update
-// NO setenv() calls - uses manual TZ calculation
-TimeInfo formatTime(int cityIndex) {
-  time_t now = time(nullptr);
-  TimeInfo info;
-
-  // Check if we need to do a batch update (minute changed or first call)
-  if (lastBatchUpdate == 0 || (now / 60) != (lastBatchUpdate / 60)) {
+// Format a date string for home city (e.g., "THU 24 MAR").
+// Writes directly to provided buffer to avoid heap allocation.
+// Reads the batch cache - only called when the home date may have changed.
+void formatDate(char *outBuf, size_t bufSize) {
+  if (!timeCacheInitialized) {
     updateAllCityTimes();
   }
-
-  // Use cached values
-  strcpy(info.timeStr, timeCache[cityIndex].timeStr);
-  info.prevDay = timeCache[cityIndex].prevDay;
-  info.nextDay = timeCache[cityIndex].nextDay;
-  info.showColon = (now % 2 == 0);  // Blink every second
-
-  return info;
+  struct tm timeinfo;
+  localTimeToTm(&timeCache.lt[0], &timeinfo);  // Always use home city
+  strftime(outBuf, bufSize, "%a %d %b", &timeinfo);
+  // Convert to uppercase in place
+  for (char *p = outBuf; *p; ++p) {
+    *p = toupper((unsigned char)*p);
+  }
 }
 
-// Draw static layout for portrait mode (240x320)
-void drawStaticLayoutPortrait() {
+// Draw static layout for portrait mode (240x320) into the panel or a band
+void drawStaticLayoutPortrait(TFT_eSPI &gfx) {
   // Title uses bitmap font for speed (rarely changes)
-  tft.setTextColor(COLOR_LABEL, COLOR_BG);
-  tft.setTextFont(2);  // Bitmap font for title
-  tft.setTextDatum(MC_DATUM);
-  tft.drawString("WORLD CLOCK", tft.width() / 2, kTitleHeight / 2 + 4);
-
-  int rows = 6;  // Home + 5 remote cities
-  int rowHeight = (tft.height() - kHeaderHeight) / rows;
-
-  // Use smooth fonts for city labels to match dynamic updates
-  setFont(kFontLabel, kFallbackLabel);
-  tft.setTextDatum(TL_DATUM);
+  gfx.setTextColor(COLOR_LABEL, COLOR_BG);
+  gfx.setTextFont(2);  // Bitmap font for title
+  gfx.setTextDatum(MC_DATUM);
+  gfx.drawString("WORLD CLOCK", tft.width() / 2, kTitleHeight / 2 + 4);
 
-  // Home city (row 0) with "Home" label
-  int rowTop = kHeaderHeight;
-  tft.setTextColor(COLOR_LABEL, COLOR_BG);
-  tft.drawString(config.homeCityLabel, kPad, rowTop + 2);
-
-  // Add small "HOME" label beneath city name
-  setFont(kFontNote, kFallbackNote);
-  tft.setTextColor(TFT_CYAN, COLOR_BG);
-  tft.drawString("HOME", kPad, rowTop + 2 + tft.fontHeight() + 4);
-
-  // Restore label font and color for remote cities
-  setFont(kFontLabel, kFallbackLabel);
-  tft.setTextColor(COLOR_LABEL, COLOR_BG);
-
-  // Remote cities (rows 1-5)
-  for (int i = 0; i < 5; ++i) {
-    rowTop = kHeaderHeight + (i + 1) * rowHeight;
-    int labelY = rowTop + 2;
-    tft.drawString(config.remoteCities[i], kPad, labelY);
-  }
+  // City labels, times and notes are widgets (renderWidgets)
 }
 
 // Draw static layout for landscape mode (320x240)
 // Left panel (120px): City name, HOME, date, analog clock, digital time, environmental data
 // Right panel (200px): 5 remote cities stacked vertically with times
-void drawStaticLayoutLandscape() {
+void drawStaticLayoutLandscape(TFT_eSPI &gfx) {
   // PERFORMANCE: Use fast bitmap fonts for static elements
   // LEFT PANEL layout: City (y=6) → HOME (y=30) → Date (y=48) → Clock (y=120) → Time (y=181) → Env (y=218)
 
   // Home city label (at top) - use smaller font for long names (>9 chars)
   int cityLen = strlen(config.homeCityLabel);
-  tft.setTextFont(cityLen > 9 ? 2 : 4);  // Bitmap fonts
-  tft.setTextDatum(TC_DATUM);
-  tft.setTextColor(COLOR_LABEL, COLOR_BG);
-  tft.drawString(config.homeCityLabel, kLeftPanelWidth / 2, 6);
+  gfx.setTextFont(cityLen > 9 ? 2 : 4);  // Bitmap fonts
+  gfx.setTextDatum(TC_DATUM);
+  gfx.setTextColor(COLOR_LABEL, COLOR_BG);
+  gfx.drawString(config.homeCityLabel, kLeftPanelWidth / 2, 6);
 
   // "HOME" indicator below city name
-  tft.setTextFont(2);  // Bitmap font
-  tft.setTextColor(TFT_CYAN, COLOR_BG);
-  tft.setTextDatum(TC_DATUM);
-  tft.drawString("HOME", kLeftPanelWidth / 2, 30);
+  gfx.setTextFont(2);  // Bitmap font
+  gfx.setTextColor(TFT_CYAN, COLOR_BG);
+  gfx.setTextDatum(TC_DATUM);
+  gfx.drawString("HOME", kLeftPanelWidth / 2, 30);
 
-  // Date will be drawn by drawHeaderDate() at y=48
+  // Date (y=48), digital time (y=181) and the right panel rows are widgets
+  // Clock face (y=120) and panel divider are part of drawStaticBackground()
+  // Environmental data will be drawn by drawEnvironmentalData() at y=218
+}
 
-  // Draw analog clock face (centered at y=120)
-  drawAnalogClockFace();
+// =========================
+// Banded DMA Static Layout
+// =========================
+// A static layout used to be fillScreen() + labels in one call: ~150 KB of
+// blocking SPI (about 30 ms at 40 MHz) during which server.handleClient() and
+// ArduinoOTA.handle() could not run. Layouts are now submitted as a job and
+// painted in DMA_BAND_LINES-line bands: each loop pass rasterises the next
+// band (background + clock face, clipped by a viewport) into one of two
+// sprite buffers while the previous band is still being sent by DMA, then
+// returns to the loop. Text labels are drawn directly once the last band is
+// out - glyph pixels only, small next to the fill.
+//
+// The first paint of each layer also draws its labels into the bands and
+// run-length encodes every band as it goes out (see Static Layer Cache).
+// Later paints of that layer - screen flips, closing diagnostics - decode
+// the runs into the band buffer instead: no clock face, no font, no labels.
+//
+// A portrait screen flip can slide the new screen in instead (see Slide
+// Transition): the same bands, paced at SLIDE_FPS, each written over the
+// lines at the top of the panel and then scrolled round to the bottom.
+
+enum StaticLayer : uint8_t {
+  LAYER_NONE,
+  LAYER_MAIN,       // Standard portrait or landscape (drawStaticLayout)
+  LAYER_ALTERNATE   // Alternate portrait screen (drawAlternatePortraitStatic)
+};
 
-  // Digital time will be drawn by drawTimesLandscape() at y=181
-  // Environmental data will be drawn by drawEnvironmentalData() at y=218
+static_assert(TFT_WIDTH % DMA_BAND_LINES == 0 && TFT_HEIGHT % DMA_BAND_LINES == 0,
+              "DMA_BAND_LINES must divide both panel dimensions");
 
-  // Divider line between left and right panels
-  tft.drawFastVLine(kLeftPanelWidth - 1, 0, tft.height(), TFT_DARKGREY);
+TFT_eSprite bandBuffer[2] = {TFT_eSprite(&tft), TFT_eSprite(&tft)};
+bool dmaReady = false;              // tft.initDMA() succeeded
+static StaticLayer pendingLayer = LAYER_NONE;
+static int16_t nextBandTop = 0;
+static uint8_t nextBandBuffer = 0;
 
-  // RIGHT PANEL: 5 Remote Cities (no horizontal lines)
-  // PERFORMANCE: Use bitmap fonts, batch by size to minimize font changes
-  tft.setTextColor(COLOR_LABEL, COLOR_BG);
-  tft.setTextDatum(TL_DATUM);
+// Redraw cost (reported in /api/state)
+uint32_t staticRedraws = 0;
+uint32_t staticBands = 0;
+uint32_t staticLastUs = 0;          // Submit -> last label drawn
+uint32_t staticLoopMaxUs = 0;       // Longest loop pass during the last redraw
+bool staticMeasuring = false;       // A redraw started since the last loop pass ended
+static uint32_t staticSubmitUs = 0;
 
-  // Pass 1: Draw short city names with font 4
-  tft.setTextFont(4);  // Bitmap font
-  for (int i = 0; i < 5; i++) {
-    if (strlen(config.remoteCities[i]) <= 9) {
-      int rowY = i * kLandscapeRemoteRowHeight + 2;
-      tft.drawString(config.remoteCities[i], kLeftPanelWidth + kPad, rowY);
-    }
-  }
+// =========================
+// Slide Transition
+// =========================
+// The ILI9341 (and ST7789) can scroll its 320 frame-memory lines round the
+// panel: VSCRDEF makes them all one scroll area, VSCRSADD picks the memory
+// line shown at the top. There are no spare lines to render off-screen, so
+// a slide works in place: each frame the next band of the incoming screen
+// is written over the memory lines at the top of the panel (the top of what
+// is left of the old screen) and the scroll start moves on by the band, so
+// those lines reappear at the bottom. After 320 / DMA_BAND_LINES frames the
+// start is back at line 0 with the new screen in memory order. A band is
+// on its way out for the ~1.5 ms its transfer takes before the scroll moves
+// it, so the slide waits for each transfer instead of overlapping the next.
+// Other panels (or no band buffers) get the plain banded repaint.
+
+#if defined(ILI9341_DRIVER) || defined(ILI9341_2_DRIVER) || defined(ST7789_DRIVER)
+#define PANEL_SCROLL_SUPPORTED 1  // VSCRDEF/VSCRSADD (also the diagnostics log)
+#else
+#define PANEL_SCROLL_SUPPORTED 0
+#endif
 
-  // Pass 2: Draw long city names with font 2 (one font switch)
-  tft.setTextFont(2);  // Smaller bitmap font
-  for (int i = 0; i < 5; i++) {
-    if (strlen(config.remoteCities[i]) > 9) {
-      int rowY = i * kLandscapeRemoteRowHeight + 2;
-      tft.drawString(config.remoteCities[i], kLeftPanelWidth + kPad, rowY);
-    }
+#if SLIDE_TRANSITION_ENABLED && PANEL_SCROLL_SUPPORTED
+#define SLIDE_SUPPORTED 1
+#else
+#define SLIDE_SUPPORTED 0
+#endif
+
+static_assert(SLIDE_FPS >= 10 && SLIDE_FPS <= 60, "SLIDE_FPS must be 10-60");
+const uint32_t kSlideFrameMs = 1000 / SLIDE_FPS;
+
+static bool slideActive = false;
+static unsigned long slideStartMs = 0;
+static unsigned long slideLastBandMs = 0;
+uint32_t slideCount = 0;            // Flips that slid
+uint32_t slideFallbacks = 0;        // Flips repainted instead (no scroll / no bands)
+uint32_t slideLastMs = 0;           // Duration of the last slide
+
+#if PANEL_SCROLL_SUPPORTED
+const uint8_t kCmdScrollArea = 0x33;   // VSCRDEF: top fixed, scroll, bottom fixed lines
+const uint8_t kCmdScrollStart = 0x37;  // VSCRSADD: memory line at the top of the area
+
+static void writeCommand16(uint8_t cmd, const uint16_t *args, int count) {
+  tft.writecommand(cmd);
+  for (int i = 0; i < count; i++) {
+    tft.writedata(args[i] >> 8);
+    tft.writedata(args[i] & 0xFF);
   }
 }
 
-// Draw the static header and location labels once.
-void drawStaticLayout() {
-  tft.fillScreen(COLOR_BG);
+// Scroll area in memory lines: `top` fixed lines, then `lines` that scroll,
+// the rest fixed
+static void setScrollArea(uint16_t top, uint16_t lines) {
+  const uint16_t area[3] = {top, lines, (uint16_t)(TFT_HEIGHT - top - lines)};
+  writeCommand16(kCmdScrollArea, area, 3);
+}
 
-  if (config.landscapeMode) {
-    drawStaticLayoutLandscape();
-  } else {
-    drawStaticLayoutPortrait();
-  }
+static void setScrollStart(uint16_t line) {
+  writeCommand16(kCmdScrollStart, &line, 1);
+}
+#endif
+
+// Whole panel one scroll area, unscrolled (memory order on screen)
+void resetPanelScroll() {
+#if PANEL_SCROLL_SUPPORTED
+  setScrollArea(0, TFT_HEIGHT);
+  setScrollStart(0);
+#endif
+}
+
+#if SLIDE_SUPPORTED
+// Memory line shown at the top once `revealed` lines of the incoming screen
+// are in place. Portrait rotation 2 writes rows bottom-up in memory, so the
+// start moves the other way to show the same slide.
+static uint16_t slideScrollLine(int revealed) {
+  int lines = TFT_HEIGHT;
+  int line = (tft.getRotation() == 2) ? lines - revealed : revealed;
+  return (uint16_t)(((line % lines) + lines) % lines);
+}
+#endif
+
+// =========================
+// Static Layer Cache
+// =========================
+// A layer's pixels in raster order as (count, colour) runs, colours as the
+// band sprite stores them. The layers are mostly COLOR_BG with a few labels
+// and a non-anti-aliased clock face, so a screen is a few hundred to a
+// couple of thousand runs. Capture starts with STATIC_CACHE_BUDGET bytes and
+// shrinks to fit once the layer is complete; a layer that doesn't fit is
+// painted from scratch until the caches are invalidated. Only what the
+// layer depends on invalidates it: the rotation (applyRotation()) and the
+// configuration (handlePostConfig()).
+
+struct StaticRun {
+  uint16_t count;
+  uint16_t color;
+};
+
+struct LayerCache {
+  StaticRun *runs;   // nullptr = not captured
+  uint32_t count;    // Runs used
+  uint32_t capacity; // Runs allocated
+  bool complete;     // Captured from a whole paint: restore from it
+  bool overflow;     // Didn't fit the budget: don't try again
+};
+
+static LayerCache layerCaches[3] = {};  // Indexed by StaticLayer
+static uint32_t layerReadRun = 0;       // Restore cursor: run index...
+static uint32_t layerReadUsed = 0;      // ...and pixels of it already decoded
+static bool layerCapturing = false;     // The pending paint is being encoded
+
+uint32_t staticCacheHits = 0;           // Layouts restored from a cache
+uint32_t staticCacheCaptures = 0;
+uint32_t staticCacheOverflows = 0;
+
+// Bytes held by complete caches (/api/state)
+uint32_t staticCacheBytes() {
+  uint32_t bytes = 0;
+  for (const LayerCache &lc : layerCaches) {
+    if (lc.complete) bytes += lc.count * sizeof(StaticRun);
+  }
+  return bytes;
+}
+
+static void freeLayerCache(LayerCache &lc) {
+  free(lc.runs);
+  lc = LayerCache();
+}
+
+// Drop every cached layer (the next paint of each captures it again)
+void invalidateLayerCaches() {
+  for (LayerCache &lc : layerCaches) {
+    freeLayerCache(lc);
+  }
+  layerCapturing = false;
+}
+
+// Append a band's pixels; false (cache dropped) when over the budget
+static bool encodeLayerBand(LayerCache &lc, const uint16_t *pixels, int n) {
+  StaticRun *last = lc.count ? &lc.runs[lc.count - 1] : nullptr;
+  for (int i = 0; i < n; i++) {
+    if (last != nullptr && last->color == pixels[i] && last->count < 0xFFFF) {
+      last->count++;
+      continue;
+    }
+    if (lc.count == lc.capacity) {
+      DBG_INFO("Static layer cache: over %u bytes, layer drawn each time\n", (unsigned)STATIC_CACHE_BUDGET);
+      freeLayerCache(lc);
+      lc.overflow = true;
+      staticCacheOverflows++;
+      return false;
+    }
+    last = &lc.runs[lc.count++];
+    last->count = 1;
+    last->color = pixels[i];
+  }
+  return true;
+}
+
+// Decode the next n pixels of a complete cache
+static void decodeLayerBand(const LayerCache &lc, uint16_t *pixels, int n) {
+  while (n > 0 && layerReadRun < lc.count) {
+    const StaticRun &run = lc.runs[layerReadRun];
+    int take = min<int>(n, run.count - layerReadUsed);
+    uint16_t color = run.color;
+    for (int i = 0; i < take; i++) {
+      pixels[i] = color;
+    }
+    pixels += take;
+    n -= take;
+    layerReadUsed += take;
+    if (layerReadUsed == run.count) {
+      layerReadRun++;
+      layerReadUsed = 0;
+    }
+  }
+}
+
+// Pick restore or capture for a layer about to be painted in bands
+static void startLayerCache(StaticLayer layer) {
+  LayerCache &lc = layerCaches[layer];
+  layerReadRun = 0;
+  layerReadUsed = 0;
+  layerCapturing = false;
+  if (lc.complete) {
+    staticCacheHits++;
+    return;
+  }
+  if (lc.overflow) return;
+  freeLayerCache(lc);  // Partial capture from an aborted paint
+  lc.capacity = STATIC_CACHE_BUDGET / sizeof(StaticRun);
+  lc.runs = (StaticRun *)malloc(lc.capacity * sizeof(StaticRun));
+  if (lc.runs == nullptr) {
+    DBG_WARN("Static layer cache: %u bytes failed (heap %u)\n", (unsigned)STATIC_CACHE_BUDGET, ESP.getFreeHeap());
+    lc.capacity = 0;
+    return;
+  }
+  layerCapturing = true;
+}
+
+// The last band of a capture is out: keep the runs, shrunk to fit
+static void completeLayerCache(StaticLayer layer) {
+  LayerCache &lc = layerCaches[layer];
+  StaticRun *fitted = (StaticRun *)realloc(lc.runs, lc.count * sizeof(StaticRun));
+  if (fitted != nullptr) {
+    lc.runs = fitted;
+    lc.capacity = lc.count;
+  }
+  lc.complete = true;
+  layerCapturing = false;
+  staticCacheCaptures++;
+  DBG_INFO("Static layer cache: layer %d, %u runs (%u bytes)\n", layer, lc.count,
+           (unsigned)(lc.count * sizeof(StaticRun)));
+}
+
+bool staticLayoutPending() {
+  return pendingLayer != LAYER_NONE;
+}
+
+// Non-text parts of a layer, drawn into gfx: the panel itself, or a band
+// sprite whose viewport origin is shifted up to the band
+static void drawStaticBackground(TFT_eSPI &gfx, StaticLayer layer) {
+  if (layer == LAYER_ALTERNATE) {
+    drawClockFace(gfx, alternateClock);
+  } else if (config.landscapeMode) {
+    // Analog clock face (centered at y=120)
+    drawClockFace(gfx, landscapeClock);
+    // Divider line between left and right panels
+    gfx.drawFastVLine(kLeftPanelWidth - 1, 0, tft.height(), TFT_DARKGREY);
+  }
+}
+
+// Labels of a layer: into the bands while it is captured, else straight to
+// the panel after the background
+static void drawStaticLabels(TFT_eSPI &gfx, StaticLayer layer) {
+  if (layer == LAYER_ALTERNATE) {
+    return;
+  }
+  if (config.landscapeMode) {
+    drawStaticLayoutLandscape(gfx);
+  } else {
+    drawStaticLayoutPortrait(gfx);
+  }
+}
+
+// Text after the last band: labels unless the bands carried them, then the
+// (never cached) environmental data
+static void drawStaticText(StaticLayer layer, bool labelsDrawn) {
+  if (!labelsDrawn) {
+    // Bitmap fonts as in the bands: drop a smooth font left on the panel
+    // (measureFont(), widgets), it would otherwise draw these labels
+    setFont(nullptr, 2);
+    drawStaticLabels(tft, layer);
+  }
+  if (layer == LAYER_ALTERNATE) {
+    DBG_VERBOSE("Alternate portrait static layout drawn\n");
+    return;
+  }
 
   // Draw environmental data (landscape mode only, if sensor available)
   drawEnvironmentalData();
 }
 
+// Allocate both band buffers at the current panel width (once per rotation)
+static bool prepareBandBuffers() {
+  for (int i = 0; i < 2; i++) {
+    TFT_eSprite &spr = bandBuffer[i];
+    if (spr.created() && spr.width() == tft.width()) continue;
+    spr.deleteSprite();
+    spr.setColorDepth(16);
+    if (spr.createSprite(tft.width(), DMA_BAND_LINES) == nullptr) {
+      DBG_WARN("Band buffers %dx%d failed (heap %u), drawing layouts directly\n",
+               tft.width(), DMA_BAND_LINES, ESP.getFreeHeap());
+      bandBuffer[0].deleteSprite();
+      bandBuffer[1].deleteSprite();
+      return false;
+    }
+  }
+  return true;
+}
+
+// Start painting a layer. Returns immediately when banding is available;
+// serviceStaticLayout() does the work from loop().
+static void submitStaticLayout(StaticLayer layer) {
+  abortStaticLayout();  // A newer layout replaces one still being painted
+  invalidateWidgets();  // The repaint blanks every widget box
+  invalidateClocks();   // ...and every clock hand
+  staticRedraws++;
+  staticSubmitUs = micros();
+  staticLoopMaxUs = 0;
+  staticMeasuring = true;
+
+#if DISPLAY_DMA_ENABLED
+  if (prepareBandBuffers()) {
+    pendingLayer = layer;
+    nextBandTop = 0;
+    nextBandBuffer = 0;
+    startLayerCache(layer);
+    if (dmaReady) {
+      tft.startWrite();  // Held until the last band is out
+    }
+    return;
+  }
+#endif
+
+  // Blocking path: DMA disabled or no RAM for the band buffers
+  tft.fillScreen(COLOR_BG);
+  drawStaticBackground(tft, layer);
+  drawStaticText(layer, false);
+  staticLastUs = micros() - staticSubmitUs;
+  renderTimers[RT_STATIC_LAYOUT].record(staticLastUs);
+}
+
+// Send the next band of the pending layout. Returns true while bands remain;
+// the call after the last band draws the labels and returns false.
+bool serviceStaticLayout() {
+  if (pendingLayer == LAYER_NONE) return false;
+  ScopedRenderTimer timer(RT_STATIC_BAND);
+
+  if (nextBandTop < tft.height()) {
+    // Rasterise (or restore) into the free buffer while the other one is
+    // still on the wire
+    TFT_eSprite &spr = bandBuffer[nextBandBuffer];
+    uint16_t *pixels = (uint16_t *)spr.getPointer();
+    const int bandPixels = tft.width() * DMA_BAND_LINES;
+    LayerCache &lc = layerCaches[pendingLayer];
+    if (lc.complete) {
+      decodeLayerBand(lc, pixels, bandPixels);
+    } else {
+      spr.fillSprite(COLOR_BG);
+      spr.setViewport(0, -nextBandTop, tft.width(), nextBandTop + DMA_BAND_LINES, true);
+      drawStaticBackground(spr, pendingLayer);
+      if (layerCapturing) {
+        drawStaticLabels(spr, pendingLayer);
+      }
+      spr.resetViewport();
+      if (layerCapturing && !encodeLayerBand(lc, pixels, bandPixels)) {
+        // Over budget mid-paint: these labels are in the bands already sent,
+        // the rest are drawn after the last band (again, over the top)
+        layerCapturing = false;
+      }
+    }
+
+    if (dmaReady) {
+      tft.dmaWait();  // Previous band sent: its buffer is free for the next pass
+      tft.pushImageDMA(0, nextBandTop, tft.width(), DMA_BAND_LINES, (uint16_t *)spr.getPointer());
+    } else {
+      spr.pushSprite(0, nextBandTop);
+    }
+    nextBandTop += DMA_BAND_LINES;
+    nextBandBuffer ^= 1;
+    staticBands++;
+#if SLIDE_SUPPORTED
+    if (slideActive) {
+      // The band is at the top of the panel: scroll it round to the bottom
+      if (dmaReady) tft.dmaWait();
+      setScrollStart(slideScrollLine(nextBandTop));
+      slideLastBandMs = millis();
+    }
+#endif
+    return true;
+  }
+
+  // All bands sent: release the bus, then draw the text on top
+  if (dmaReady) {
+    tft.dmaWait();
+    tft.endWrite();
+  }
+  StaticLayer layer = pendingLayer;
+  pendingLayer = LAYER_NONE;
+  if (slideActive) {
+    slideActive = false;
+    slideLastMs = millis() - slideStartMs;
+  }
+  bool labelsInBands = layerCaches[layer].complete;
+  if (layerCapturing) {
+    completeLayerCache(layer);
+    labelsInBands = true;
+  }
+  drawStaticText(layer, labelsInBands);
+  staticLastUs = micros() - staticSubmitUs;
+  renderTimers[RT_STATIC_LAYOUT].record(staticLastUs);
+  return false;
+}
+
+// Drop a pending layout (the screen is about to be replaced anyway).
+// Must run before anything else touches the panel while a band is in flight.
+void abortStaticLayout() {
+  if (pendingLayer == LAYER_NONE) return;
+  if (dmaReady) {
+    tft.dmaWait();
+    tft.endWrite();
+  }
+  pendingLayer = LAYER_NONE;
+  layerCapturing = false;  // The partial capture is dropped on the next paint
+#if SLIDE_SUPPORTED
+  if (slideActive) {
+    setScrollStart(0);  // Mid-slide: whoever aborted repaints unscrolled
+    slideActive = false;
+  }
+#endif
+}
+
+// Milliseconds until the pending layout's next band is due: 0 (as fast as
+// the loop runs) except between slide frames
+uint32_t msUntilStaticBand() {
+  if (!slideActive || nextBandTop >= tft.height()) return 0;
+  unsigned long elapsed = millis() - slideLastBandMs;
+  return (elapsed >= kSlideFrameMs) ? 0 : (uint32_t)(kSlideFrameMs - elapsed);
+}
+
+// Paint the rest of a pending layout now (before reading the panel back)
+void finishStaticLayout() {
+  while (serviceStaticLayout()) {
+  }
+}
+
+// Draw the static header and location labels once.
+void drawStaticLayout() {
+  submitStaticLayout(LAYER_MAIN);
+}
+
+// Portrait screen flip: slide the layer in when the panel can scroll and
+// the layer is painted in bands, else the plain banded repaint
+void slideStaticLayout(StaticLayer layer) {
+  submitStaticLayout(layer);
+#if SLIDE_SUPPORTED
+  if (pendingLayer == layer && tft.height() == TFT_HEIGHT) {
+    setScrollArea(0, TFT_HEIGHT);  // No fixed lines
+    slideActive = true;
+    slideStartMs = millis();
+    slideLastBandMs = slideStartMs - kSlideFrameMs;  // First band at once
+    slideCount++;
+    return;
+  }
+#endif
+  slideFallbacks++;
+}
+
 // Draw or update the header date string.
 // Draw environmental sensor data in landscape mode (left panel)
 // Only draws if sensor is available and in landscape mode
@@ -1221,6 +1953,7 @@ void drawEnvironmentalData() {
   if (!config.landscapeMode || !sensorAvailable) {
     return;  // Only show in landscape mode when sensor available
   }
+  ScopedRenderTimer timer(RT_ENV_DATA);
 
   int displayTemp = config.useFahrenheit ? (int)(temperature * 9.0 / 5.0 + 32) : (int)temperature;
   const char* tempUnit = config.useFahrenheit ? "o""F" : "o""C";  // °F or °C
@@ -1248,7 +1981,7 @@ void drawEnvironmentalData() {
 
   // Draw below digital time (time at y=181, this at y=218)
   int envY = 218;
-  tft.setTextFont(2);  // Bitmap font for faster rendering
+  setFont(nullptr, 2);  // Bitmap font for faster rendering (unloads a smooth one)
 
   // Get temperature color (always use Celsius for color determination)
   uint16_t tempColor = getTemperatureColor(temperature);
@@ -1259,505 +1992,791 @@ void drawEnvironmentalData() {
   tft.setTextPadding(0);  // Reset padding
 }
 
-void drawHeaderDate(const char *dateStr) {
-  // PERFORMANCE: Use bitmap font for static date element
-  tft.setTextFont(2);  // Bitmap font
-  tft.setTextColor(COLOR_TIME, COLOR_BG);
+// =========================
+// Damage Tracking & Widget Compositor
+// =========================
+// Everything on the clock screens that changes after the static layout is a
+// text widget: a screen box plus a content source (city time, label, day
+// note, date, page, sensor line). Each frame every widget of the current
+// layout recomputes its text and colour; one that differs from what it last
+// drew marks its box dirty. Dirty boxes are merged (when they overlap, or
+// tile with no wasted pixels) and each merged rect is composed off-screen -
+// background plus every widget that intersects it, clipped to its box - and
+// pushed to the panel as one window. framePixels counts what each frame sent,
+// so overdraw shows up as a number instead of flicker.
+//
+// Time widgets are laid out as five fixed glyph cells (digit width for the
+// digits, colon width for the colon). They damage only the cells whose
+// character changed: a blink tick resends the colon cell, a minute tick the
+// digits that rolled over.
+
+enum WidgetSource : uint8_t {
+  SRC_DATE,         // Header date (home city)
+  SRC_PAGE,         // "page/pages" when the remote cities don't fit
+  SRC_CITY_TIME,    // HH:MM of the city in the widget's row
+  SRC_CITY_LABEL,   // City name
+  SRC_CITY_NOTE,    // Prev/Next Day (HOME for the portrait home row)
+  SRC_HOME_HEADER,  // "Home: CITY" (alternate screen)
+  SRC_TEMPERATURE,  // Sensor lines (alternate screen)
+  SRC_HUMIDITY,
+  SRC_PRESSURE
+};
 
-  if (config.landscapeMode) {
-    // Landscape: date in left panel, below HOME indicator (y=48)
-    tft.setTextDatum(TC_DATUM);
-    tft.fillRect(0, 46, kLeftPanelWidth - 2, 18, COLOR_BG);  // Clear date area
-    tft.drawString(dateStr, kLeftPanelWidth / 2, 48);
-  } else {
-    // Portrait: centered date below title (full width)
-    tft.setTextDatum(MC_DATUM);
-    tft.fillRect(0, kTitleHeight, tft.width(), kDateHeight, COLOR_BG);
-    tft.drawString(dateStr, tft.width() / 2, kTitleHeight + kDateHeight / 2 + 2);
-  }
-}
+enum WidgetLayout : uint8_t {
+  WL_NONE,
+  WL_PORTRAIT,
+  WL_LANDSCAPE,
+  WL_ALTERNATE,
+  WL_COUNT
+};
 
-// Draw times for portrait mode (240x320)
-void drawTimesPortrait() {
-  int rows = 6;  // Home + 5 remote cities
-  int rowHeight = (tft.height() - kHeaderHeight) / rows;
+struct TextWidget {
+  int16_t x, y, w, h;     // Box: repainted as a whole, text clipped to it
+  int16_t tx, ty;         // Text anchor for datum
+  uint8_t datum;
+  uint8_t source;         // WidgetSource
+  int8_t row;             // 0 = home, 1..REMOTE_ROWS_PER_PAGE = remote rows
+  bool blink;             // Time colon blinks
+  int8_t digitW;          // Glyph cell widths (> 0: HH:MM in fixed cells)
+  int8_t colonW;
+  bool upperNote;         // "PREV DAY" instead of "Prev Day"
+  const char *font;       // Smooth font, nullptr = bitmap font only
+  uint8_t fallback;       // Bitmap font
+  bool valid;             // text/color are what the panel shows
+  uint16_t color;         // Drawn colour
+  char text[6 + sizeof(Config::homeCityLabel)];  // Drawn text ("" = blank box), fits "Home: CITY"
+};
 
-  // Load time font once before loop
-  setFont(kFontTime, kFallbackTime);
-  if (timePadWidth == 0) {
-    timePadWidth = tft.textWidth("88:88");
-  }
+const int kMaxWidgets = 24;
+TextWidget widgets[kMaxWidgets];
+uint8_t widgetCount = 0;
+WidgetLayout widgetLayout = WL_NONE;
+int16_t widgetLayoutWidth = 0;  // tft.width() the layout was built for
+char dateText[16] = "";         // Reformatted on minute boundaries by loop()
 
-  // Helper to get city label by index
-  auto getLabelByIndex = [](int i) -> const char* {
-    if (i == 0) return config.homeCityLabel;
-    return config.remoteCities[i - 1];
-  };
+// Dirty rectangles, half-open [x0, x1) x [y0, y1)
+struct DamageRect {
+  int16_t x0, y0, x1, y1;
+};
 
-  for (int i = 0; i < rows; ++i) {
-    TimeInfo info = formatTime(i);
-    bool timeChanged = (strcmp(info.timeStr, lastTimes[i]) != 0);
-    bool prevDayChanged = (info.prevDay != lastPrevDay[i]);
-    bool nextDayChanged = (info.nextDay != lastNextDay[i]);
-    bool colonChanged = (info.showColon != lastColonState[i]);
-    if (!timeChanged && !prevDayChanged && !nextDayChanged && !colonChanged) {
-      continue;
-    }
+const int kMaxDamageRects = 16;
+DamageRect damageRects[kMaxDamageRects];
+uint8_t damageCount = 0;
+
+// Per-frame cost (reported in /api/state)
+uint32_t frameCount = 0;
+uint32_t framePixels = 0;       // Pixels pushed by the last frame
+uint32_t frameWindows = 0;      // Panel windows opened by the last frame
+uint32_t frameMaxPixels = 0;
+uint32_t frameTotalPixels = 0;
+uint32_t frameLastUs = 0;
+uint32_t composeFallbacks = 0;  // Rects drawn directly (no sprite memory)
+
+// SPI cost per screen mode. One frame runs per second, so bytes per frame is
+// the per-second display traffic for text (clock hands not included).
+const uint32_t kWindowSetupBytes = 11;  // CASET + RASET + RAMWR with parameters
+uint32_t frameBytes = 0;                // Last frame
+uint32_t layoutFrames[WL_COUNT] = {0};
+uint64_t layoutBytes[WL_COUNT] = {0};
+
+// Off-screen compose buffers, reused by size: the per-second rects (time
+// boxes) keep hitting the same slot, its buffer and its loaded font.
+struct ComposeSlot {
+  TFT_eSprite sprite;
+  int16_t width;          // 0 = free
+  int16_t height;
+  const char *font;       // Smooth font loaded in the sprite (see setFontOn)
+  uint32_t lastUsed;      // For least-recently-used replacement
+};
 
-    int rowTop = kHeaderHeight + i * rowHeight;
-    int timeY = rowTop + 2;
+ComposeSlot composePool[COMPOSE_POOL_SIZE] = {
+  {TFT_eSprite(&tft), 0, 0, nullptr, 0},
+  {TFT_eSprite(&tft), 0, 0, nullptr, 0},
+  {TFT_eSprite(&tft), 0, 0, nullptr, 0},
+};
+static_assert(COMPOSE_POOL_SIZE == 3, "composePool initializer must match COMPOSE_POOL_SIZE");
 
-    // Draw time (font already loaded before loop)
-    if (timeChanged || prevDayChanged || nextDayChanged || colonChanged) {
-      tft.setTextPadding(timePadWidth);
-      tft.setTextColor(COLOR_TIME, COLOR_BG);
-      tft.setTextDatum(TR_DATUM);
+static int32_t rectArea(const DamageRect &r) {
+  return (int32_t)(r.x1 - r.x0) * (r.y1 - r.y0);
+}
 
-      // Build time string with colon or space for blinking
-      char displayTime[8];
-      strcpy(displayTime, info.timeStr);
-      if (!info.showColon) {
-        displayTime[2] = ' ';  // Replace colon with space
-      }
-      tft.drawString(displayTime, tft.width() - kPad, timeY);
-    }
+static DamageRect rectUnion(const DamageRect &a, const DamageRect &b) {
+  return {min(a.x0, b.x0), min(a.y0, b.y0), max(a.x1, b.x1), max(a.y1, b.y1)};
+}
 
-    // Draw labels and day indicators (only switch fonts when needed)
-    if (prevDayChanged || nextDayChanged) {
-      int labelClearWidth = tft.width() / 2 - kPad - 4;
-      tft.fillRect(kPad, rowTop, labelClearWidth, rowHeight, COLOR_BG);
+// Overlapping rects must merge (else pixels are sent twice). Disjoint ones
+// merge only if their union wastes nothing, i.e. they tile along a full edge.
+static bool shouldMerge(const DamageRect &a, const DamageRect &b) {
+  bool overlap = a.x0 < b.x1 && b.x0 < a.x1 && a.y0 < b.y1 && b.y0 < a.y1;
+  return overlap || rectArea(rectUnion(a, b)) <= rectArea(a) + rectArea(b);
+}
 
-      setFont(kFontLabel, kFallbackLabel);
-      tft.setTextColor(COLOR_LABEL, COLOR_BG);
-      tft.setTextDatum(TL_DATUM);
-      tft.drawString(getLabelByIndex(i), kPad, rowTop + 2);
+// Mark a screen region for repaint this frame
+void markDamage(int x, int y, int w, int h) {
+  DamageRect r = {(int16_t)max(x, 0), (int16_t)max(y, 0),
+                  (int16_t)min(x + w, (int)tft.width()), (int16_t)min(y + h, (int)tft.height())};
+  if (r.x0 >= r.x1 || r.y0 >= r.y1) return;
+
+  // Absorb every rect this one merges with (the union may then reach others)
+  for (int i = 0; i < damageCount; i++) {
+    if (shouldMerge(r, damageRects[i])) {
+      r = rectUnion(r, damageRects[i]);
+      damageRects[i] = damageRects[--damageCount];
+      i = -1;  // Rescan
+    }
+  }
 
-      if (info.prevDay || info.nextDay) {
-        setFont(kFontNote, kFallbackNote);
-        tft.setTextColor(info.prevDay ? TFT_YELLOW : TFT_CYAN, COLOR_BG);
-        tft.drawString(info.prevDay ? "Prev Day" : "Next Day", kPad, rowTop + 2 + tft.fontHeight() + 2);
-        // Restore time font for next iteration
-        setFont(kFontTime, kFallbackTime);
+  if (damageCount == kMaxDamageRects) {
+    // List full: fold into the rect that grows least
+    int best = 0;
+    int32_t bestGrowth = INT32_MAX;
+    for (int i = 0; i < damageCount; i++) {
+      int32_t growth = rectArea(rectUnion(r, damageRects[i])) - rectArea(damageRects[i]);
+      if (growth < bestGrowth) {
+        bestGrowth = growth;
+        best = i;
       }
     }
-
-    strlcpy(lastTimes[i], info.timeStr, sizeof(lastTimes[i]));
-    lastPrevDay[i] = info.prevDay;
-    lastNextDay[i] = info.nextDay;
-    lastColonState[i] = info.showColon;
+    r = rectUnion(r, damageRects[best]);
+    damageRects[best] = damageRects[--damageCount];
   }
+  damageRects[damageCount++] = r;
 }
 
-// Draw times for landscape mode (320x240)
-// Left panel: Analog clock + digital time below
-// Right panel: Times right-aligned, PREV DAY tiny below city label
-void drawTimesLandscape() {
-  // Load time font once before any time drawing
-  setFont(kFontTime, kFallbackTime);
-  if (timePadWidth == 0) {
-    timePadWidth = tft.textWidth("88:88");
+// Forget what the widgets drew. Called after a static layout repaint, which
+// leaves every widget box blank.
+void invalidateWidgets() {
+  for (int i = 0; i < widgetCount; i++) {
+    widgets[i].valid = false;
   }
+}
 
-  // Get home city time for analog clock
-  time_t now = time(nullptr);
-  struct tm homeTm;
-  getLocalTimeNoSetenv(now, &parsedTz[0], &homeTm);
-
-  // Update analog clock hands (every second)
-  updateAnalogClockHands(homeTm.tm_hour, homeTm.tm_min, homeTm.tm_sec);
-
-  // HOME CITY DIGITAL TIME (left panel, below analog clock)
-  // Font already loaded above
-  {
-    TimeInfo info = formatTime(0);
-    bool timeChanged = (strcmp(info.timeStr, lastTimes[0]) != 0);
-    bool colonChanged = (info.showColon != lastColonState[0]);
-
-    if (timeChanged || colonChanged) {
-      int homeTimeY = 181;  // Below analog clock (center Y=120, radius=50), moved up 4px for sensor data
-
-      tft.setTextPadding(timePadWidth);
-      tft.setTextColor(COLOR_TIME, COLOR_BG);
-      tft.setTextDatum(TC_DATUM);
+static WidgetLayout activeWidgetLayout() {
+  if (config.landscapeMode) return WL_LANDSCAPE;
+  if (sensorAvailable && config.enableScreenRotation && showingAlternateScreen) return WL_ALTERNATE;
+  return WL_PORTRAIT;
+}
 
-      // Build time string with colon or space for blinking
-      char displayTime[8];
-      strcpy(displayTime, info.timeStr);
-      if (!info.showColon) {
-        displayTime[2] = ' ';  // Replace colon with space
-      }
-      tft.drawString(displayTime, kLeftPanelWidth / 2, homeTimeY);
+static TextWidget *addWidget(uint8_t source, int row, int x, int y, int w, int h,
+                             int tx, int ty, uint8_t datum, const char *font, int fallback) {
+  if (widgetCount >= kMaxWidgets) return nullptr;
+  TextWidget *wd = &widgets[widgetCount++];
+  *wd = TextWidget{};
+  wd->x = x;
+  wd->y = y;
+  wd->w = w;
+  wd->h = h;
+  wd->tx = tx;
+  wd->ty = ty;
+  wd->datum = datum;
+  wd->source = source;
+  wd->row = row;
+  wd->font = font;
+  wd->fallback = fallback;
+  return wd;
+}
 
-      strlcpy(lastTimes[0], info.timeStr, sizeof(lastTimes[0]));
-      lastPrevDay[0] = info.prevDay;
-      lastNextDay[0] = info.nextDay;
-      lastColonState[0] = info.showColon;
-    }
+// Give a time widget fixed HH:MM glyph cells: the box becomes exactly
+// 4 digits + colon wide and the text is laid out from its left edge
+static void setGlyphCells(TextWidget *wd, int digitW, int colonW) {
+  if (wd == nullptr) return;
+  int w = 4 * digitW + colonW;
+  if (wd->datum == TR_DATUM) {
+    wd->x = wd->tx - w;
+  } else if (wd->datum == TC_DATUM) {
+    wd->x = wd->tx - w / 2;
   }
+  wd->w = w;
+  wd->digitW = digitW;
+  wd->colonW = colonW;
+}
 
-  // REMOTE CITIES TIMES (right panel - 200px wide)
-  // Layout: City label at top, Time below (right-aligned), PREV/NEXT DAY at bottom
-  for (int i = 0; i < 5; i++) {
-    int cityIndex = i + 1;
-    TimeInfo info = formatTime(cityIndex);
-    bool timeChanged = (strcmp(info.timeStr, lastTimes[cityIndex]) != 0);
-    bool prevDayChanged = (info.prevDay != lastPrevDay[cityIndex]);
-    bool nextDayChanged = (info.nextDay != lastNextDay[cityIndex]);
-    bool colonChanged = (info.showColon != lastColonState[cityIndex]);
+// Screen x and width of glyph cell i (0-4) of a time widget
+static void glyphCell(const TextWidget &wd, int i, int *x, int *w) {
+  static const uint8_t digitsBefore[5] = {0, 1, 2, 2, 3};
+  *x = wd.x + digitsBefore[i] * wd.digitW + (i > 2 ? wd.colonW : 0);
+  *w = (i == 2) ? wd.colonW : wd.digitW;
+}
 
-    if (!timeChanged && !prevDayChanged && !nextDayChanged && !colonChanged) {
-      continue;
-    }
+// Width of sample and line height in a font (loads it on tft; layout
+// rebuilds only)
+static void measureFont(const char *font, int fallback, const char *sample, int16_t *w, int16_t *h) {
+  setFont(font, fallback);
+  *w = tft.textWidth(sample);
+  *h = tft.fontHeight();
+}
 
-    int rowY = i * kLandscapeRemoteRowHeight;
-    int cityLabelY = rowY + 2;     // City label at top
-    int timeY = rowY + 20;         // Time right-aligned
+// =========================
+// Digit Glyph Cache
+// =========================
+// Smooth font glyphs are alpha-blended pixel by pixel on every draw. The
+// time glyphs "0123456789:" of each time font are rendered once, in their
+// glyph cells, into an RGB565 strip against the background. Painting a time
+// cell is then a row-by-row memcpy into the compose sprite with no font
+// loaded at all. Strips are built in priority order (kFontTime first) until
+// GLYPH_CACHE_BUDGET bytes are used; a font that doesn't fit, or whose
+// strip can't be allocated, keeps drawing through the font.
+
+struct GlyphCache {
+  TFT_eSprite strip;      // 10 digit cells then the colon cell, one row each
+  const char *font;       // nullptr = slot unused
+  uint8_t fallback;
+  int8_t digitW;
+  int8_t colonW;
+  int16_t height;
+  uint16_t fg;
+};
 
-    if (timeChanged || prevDayChanged || nextDayChanged) {
-      // Clear the entire row area for this city (except divider line)
-      tft.fillRect(kLeftPanelWidth + 1, rowY, kRightPanelWidth - 1, kLandscapeRemoteRowHeight, COLOR_BG);
+const int kGlyphCacheFonts = 2;  // kFontTime, kFontLabel
+GlyphCache glyphCaches[kGlyphCacheFonts] = {
+  {TFT_eSprite(&tft), nullptr, 0, 0, 0, 0, 0},
+  {TFT_eSprite(&tft), nullptr, 0, 0, 0, 0, 0},
+};
+uint32_t glyphCacheBytes = 0;
+uint32_t glyphCacheBlits = 0;    // Glyph cells copied from a strip
+uint32_t glyphCacheSkipped = 0;  // Fonts left uncached (budget or heap)
+
+// Render a font's time glyphs into a free cache slot
+static void buildGlyphCache(const char *font, int fallback, int digitW, int colonW, int height, uint16_t fg) {
+  GlyphCache *gc = nullptr;
+  for (int i = 0; i < kGlyphCacheFonts && gc == nullptr; i++) {
+    if (glyphCaches[i].font == nullptr) gc = &glyphCaches[i];
+  }
+  int stripW = 10 * digitW + colonW;
+  uint32_t bytes = (uint32_t)stripW * height * 2;
+  if (gc == nullptr || glyphCacheBytes + bytes > GLYPH_CACHE_BUDGET) {
+    DBG_INFO("Glyph cache: %s not cached (%u bytes, budget %u)\n",
+             font ? font : "bitmap", bytes, (unsigned)GLYPH_CACHE_BUDGET);
+    glyphCacheSkipped++;
+    return;
+  }
 
-      // Redraw city label
-      setFont(kFontLabel, kFallbackLabel);
-      tft.setTextColor(COLOR_LABEL, COLOR_BG);
-      tft.setTextDatum(TL_DATUM);
-      tft.drawString(config.remoteCities[i], kLeftPanelWidth + kPad, cityLabelY);
+  TFT_eSprite &spr = gc->strip;
+  spr.setColorDepth(16);
+  if (spr.createSprite(stripW, height) == nullptr) {
+    DBG_WARN("Glyph cache: %dx%d strip failed (heap %u)\n", stripW, height, ESP.getFreeHeap());
+    glyphCacheSkipped++;
+    return;
+  }
 
-      // Draw PREV DAY or NEXT DAY indicator (only switch font once)
-      if (info.prevDay || info.nextDay) {
-        setFont(kFontNote, kFallbackNote);
-        tft.setTextColor(info.prevDay ? TFT_YELLOW : TFT_CYAN, COLOR_BG);
-        tft.setTextDatum(TL_DATUM);
-        tft.drawString(info.prevDay ? "PREV DAY" : "NEXT DAY", kLeftPanelWidth + kPad, cityLabelY + tft.fontHeight() + 2);
-      }
-    }
+  // Same rendering as paintWidgets: each glyph centred in its clipped cell
+  const char *loaded = nullptr;
+  setFontOn(spr, loaded, font, fallback);
+  spr.fillSprite(COLOR_BG);
+  spr.setTextColor(fg, COLOR_BG);
+  spr.setTextDatum(TC_DATUM);
+  for (int g = 0; g < 11; g++) {
+    int x = g * digitW;
+    int w = (g == 10) ? colonW : digitW;
+    char glyph[2] = {kTimeGlyphs[g], '\0'};
+    spr.setViewport(x, 0, w, height, false);
+    spr.drawString(glyph, x + w / 2, 0);
+  }
+  spr.resetViewport();
+  if (loaded != nullptr) {
+    spr.unloadFont();  // The pixels are all we keep
+  }
 
-    // Draw time right-aligned (font already loaded before loop)
-    if (timeChanged || colonChanged) {
-      setFont(kFontTime, kFallbackTime);
-      tft.setTextPadding(timePadWidth);
-      tft.setTextColor(COLOR_TIME, COLOR_BG);
-      tft.setTextDatum(TR_DATUM);
+  gc->font = font;
+  gc->fallback = fallback;
+  gc->digitW = digitW;
+  gc->colonW = colonW;
+  gc->height = height;
+  gc->fg = fg;
+  glyphCacheBytes += bytes;
+  DBG_INFO("Glyph cache: %s %dx%d (%u bytes)\n", font ? font : "bitmap", stripW, height, bytes);
+}
 
-      // Build time string with colon or space for blinking
-      char displayTime[8];
-      strcpy(displayTime, info.timeStr);
-      if (!info.showColon) {
-        displayTime[2] = ' ';  // Replace colon with space
-      }
-      tft.drawString(displayTime, tft.width() - 6, timeY);
+// Strip matching a time widget's font, cells and colour, or nullptr
+static GlyphCache *findGlyphCache(const TextWidget &wd) {
+  for (int i = 0; i < kGlyphCacheFonts; i++) {
+    GlyphCache &gc = glyphCaches[i];
+    if (gc.font != nullptr && gc.font == wd.font && gc.fallback == wd.fallback &&
+        gc.digitW == wd.digitW && gc.colonW == wd.colonW && gc.fg == wd.color) {
+      return &gc;
     }
-
-    strlcpy(lastTimes[cityIndex], info.timeStr, sizeof(lastTimes[cityIndex]));
-    lastPrevDay[cityIndex] = info.prevDay;
-    lastNextDay[cityIndex] = info.nextDay;
-    lastColonState[cityIndex] = info.showColon;
   }
+  return nullptr;
 }
 
-// Draw times for each location and update only when needed.
-// Uses cached time values - NO setenv() calls
-void drawTimes() {
-  if (config.landscapeMode) {
-    drawTimesLandscape();
-  } else {
-    drawTimesPortrait();
+// Copy a time widget's glyph cells, clipped to (cx0, cy0)-(cx1, cy1), into
+// a sprite buffer of width aw whose pixel (0, 0) is screen (ox, oy)
+static void blitGlyphCells(const TextWidget &wd, GlyphCache &gc, uint16_t *pixels, int aw,
+                           int cx0, int cy0, int cx1, int cy1, int ox, int oy) {
+  const uint16_t *strip = (const uint16_t *)gc.strip.getPointer();
+  const int stripW = 10 * gc.digitW + gc.colonW;
+  int y0 = max(cy0, (int)wd.ty);
+  int y1 = min(cy1, wd.ty + gc.height);
+
+  for (int g = 0; g < 5 && wd.text[g] != '\0'; g++) {
+    char c = wd.text[g];
+    int src;
+    if (c >= '0' && c <= '9') {
+      src = (c - '0') * gc.digitW;
+    } else if (c == ':') {
+      src = 10 * gc.digitW;
+    } else {
+      continue;  // Blank colon: background already
+    }
+    int gx, gw;
+    glyphCell(wd, g, &gx, &gw);
+    int gx0 = max(gx, cx0);
+    int gx1 = min(gx + gw, cx1);
+    if (gx0 >= gx1) continue;
+    for (int y = y0; y < y1; y++) {
+      memcpy(pixels + (y - oy) * aw + (gx0 - ox),
+             strip + (y - wd.ty) * stripW + src + (gx0 - gx),
+             (gx1 - gx0) * sizeof(uint16_t));
+    }
+    glyphCacheBlits++;
   }
 }
 
-// =========================
-// Alternate Portrait Screen (with Analogue Clock + Environmental Data)
-// =========================
-// This screen alternates with the standard portrait screen when environmental
-// sensor is available and screen rotation is enabled.
-//
-// Layout (240x320):
-// - Header: "Home: CITYNAME" centered (y=4)
-// - Home time: Large, centered on right side (y=30)
-// - Analogue clock (left, center at 60,80) + Sensor data (right, y=70-98)
-// - Clock bottom edge at y=135 (no cropping)
-// - Sensor data always shown (Temp, Hum, Press) with "n/a" when unavailable
-// - Remote cities: 2-line format (y=137-320, 5 cities × 37px)
-// - Day indicators ("Prev Day"/"Next Day") directly below city name, no indent
-// - No separator lines between cities
-
-// Draw static layout for alternate portrait screen
-void drawAlternatePortraitStatic() {
-  tft.fillScreen(COLOR_BG);
-
-  // Draw analogue clock face (top-left position)
-  const int clockCenterX = 60;
-  const int clockCenterY = 80;
-  const int clockRadius = 55;
-
-  // Clock face circle
-  tft.drawCircle(clockCenterX, clockCenterY, clockRadius, TFT_DARKGREY);
+// Lay out the widgets for the screen that is showing. Boxes follow the
+// positions the static layouts leave free for them.
+static void buildWidgetLayout(WidgetLayout layout) {
+  const int W = tft.width();
+
+  // Font metrics never change after boot: measure once
+  static bool measured = false;
+  static int16_t timeW, timeH, labelW, labelH, noteW, noteH, envW, envH;
+  static int16_t timeDigitW, timeColonW, labelDigitW, labelColonW;
+  if (!measured) {
+    measureFont(kFontTime, kFallbackTime, ":", &timeColonW, &timeH);
+    measureFont(kFontTime, kFallbackTime, "8", &timeDigitW, &timeH);
+    measureFont(kFontLabel, kFallbackLabel, ":", &labelColonW, &labelH);
+    measureFont(kFontLabel, kFallbackLabel, "8", &labelDigitW, &labelH);
+    timeW = 4 * timeDigitW + timeColonW;
+    labelW = 4 * labelDigitW + labelColonW;
+    buildGlyphCache(kFontTime, kFallbackTime, timeDigitW, timeColonW, timeH, COLOR_TIME);
+    buildGlyphCache(kFontLabel, kFallbackLabel, labelDigitW, labelColonW, labelH, COLOR_TIME);
+    measureFont(kFontLabel, kFallbackLabel, "P 8888hPa", &envW, &envH);
+    measureFont(kFontNote, kFallbackNote, "88/88", &noteW, &noteH);
+    measured = true;
+  }
 
-  // Hour markers (12 positions)
-  for (int i = 0; i < 12; i++) {
-    float angleDeg = i * 30.0f;
-    float angleRad = (angleDeg - 90.0f) * PI / 180.0f;
-    int outerR = clockRadius - 3;
-    int innerR = clockRadius - 8;
-    int x1 = clockCenterX + innerR * cos(angleRad);
-    int y1 = clockCenterY + innerR * sin(angleRad);
-    int x2 = clockCenterX + outerR * cos(angleRad);
-    int y2 = clockCenterY + outerR * sin(angleRad);
+  widgetCount = 0;
+  TextWidget *wd;
+
+  if (layout == WL_PORTRAIT) {
+    addWidget(SRC_DATE, 0, 0, kTitleHeight, W, kDateHeight,
+              W / 2, kTitleHeight + kDateHeight / 2 + 2, MC_DATUM, nullptr, kFallbackHeader);
+    addWidget(SRC_PAGE, 0, W - kPad - noteW, 0, noteW, kTitleHeight,
+              W - kPad, kTitleHeight / 2 + 4, MR_DATUM, kFontNote, kFallbackNote);
+
+    // Home + one page of remote rows: label and note on the left, time right
+    int rowHeight = (tft.height() - kHeaderHeight) / (REMOTE_ROWS_PER_PAGE + 1);
+    int timeX = W - kPad - timeW;
+    int textW = timeX - kPad - 2;
+    for (int row = 0; row <= REMOTE_ROWS_PER_PAGE; row++) {
+      int rowTop = kHeaderHeight + row * rowHeight;
+      int noteY = rowTop + 2 + labelH + 2;
+      wd = addWidget(SRC_CITY_TIME, row, timeX, rowTop + 2, timeW, timeH,
+                     W - kPad, rowTop + 2, TR_DATUM, kFontTime, kFallbackTime);
+      setGlyphCells(wd, timeDigitW, timeColonW);
+      if (wd) wd->blink = true;
+      addWidget(SRC_CITY_LABEL, row, kPad, rowTop, textW, noteY - rowTop,
+                kPad, rowTop + 2, TL_DATUM, kFontLabel, kFallbackLabel);
+      addWidget(SRC_CITY_NOTE, row, kPad, noteY, textW, noteH,
+                kPad, noteY, TL_DATUM, kFontNote, kFallbackNote);
+    }
+  } else if (layout == WL_LANDSCAPE) {
+    // Left panel: date below HOME (y=48), home time below the clock (y=181)
+    addWidget(SRC_DATE, 0, 0, 46, kLeftPanelWidth - 2, 18,
+              kLeftPanelWidth / 2, 48, TC_DATUM, nullptr, kFallbackHeader);
+    wd = addWidget(SRC_CITY_TIME, 0, kLeftPanelWidth / 2 - timeW / 2, 181, timeW, timeH,
+                   kLeftPanelWidth / 2, 181, TC_DATUM, kFontTime, kFallbackTime);
+    setGlyphCells(wd, timeDigitW, timeColonW);
+    if (wd) wd->blink = true;
+
+    // Right panel rows: label on top, time right-aligned below, note left of it
+    int x0 = kLeftPanelWidth + 1;
+    int rowW = kRightPanelWidth - 1;
+    int timeX = W - 6 - timeW;
+    for (int i = 0; i < REMOTE_ROWS_PER_PAGE; i++) {
+      int rowY = i * kLandscapeRemoteRowHeight;
+      int timeY = rowY + 20;
+      addWidget(SRC_CITY_LABEL, i + 1, x0, rowY, rowW, 20,
+                kLeftPanelWidth + kPad, rowY + 2, TL_DATUM, kFontLabel, kFallbackLabel);
+      wd = addWidget(SRC_CITY_TIME, i + 1, timeX, timeY, timeW, min((int)timeH, kLandscapeRemoteRowHeight - 20),
+                     W - 6, timeY, TR_DATUM, kFontTime, kFallbackTime);
+      setGlyphCells(wd, timeDigitW, timeColonW);
+      if (wd) wd->blink = true;
+      wd = addWidget(SRC_CITY_NOTE, i + 1, x0, timeY, timeX - x0, kLandscapeRemoteRowHeight - 20,
+                     kLeftPanelWidth + kPad, timeY + 2, TL_DATUM, kFontNote, kFallbackNote);
+      if (wd) wd->upperNote = true;
+    }
+  } else {
+    // Alternate portrait: header, home time and sensor lines right of the
+    // clock face, then a compact remote list from y=137 (37px rows)
+    const int centerX = 180;
+
+    addWidget(SRC_HOME_HEADER, 0, 0, 4, W, labelH,
+              W / 2, 4, TC_DATUM, kFontLabel, kFallbackLabel);
+    wd = addWidget(SRC_CITY_TIME, 0, centerX - timeW / 2, 30, timeW, timeH,
+                   centerX, 30, TC_DATUM, kFontTime, kFallbackTime);
+    setGlyphCells(wd, timeDigitW, timeColonW);
+    const uint8_t envSources[] = {SRC_TEMPERATURE, SRC_HUMIDITY, SRC_PRESSURE};
+    for (int i = 0; i < 3; i++) {
+      int y = 70 + i * 18;
+      addWidget(envSources[i], 0, centerX - envW / 2, y, envW, envH,
+                centerX, y, TC_DATUM, kFontLabel, kFallbackLabel);
+    }
 
-    // Thicker markers at 12, 3, 6, 9
-    int thickness = (i % 3 == 0) ? 2 : 1;
-    for (int t = 0; t < thickness; t++) {
-      tft.drawLine(x1, y1 + t, x2, y2 + t, TFT_WHITE);
+    for (int i = 0; i < REMOTE_ROWS_PER_PAGE; i++) {
+      int cityY = 137 + i * 37 + 4;
+      int noteY = cityY + noteH + 2;
+      addWidget(SRC_CITY_LABEL, i + 1, kPad, cityY, 120, noteH,
+                kPad, cityY, TL_DATUM, kFontNote, kFallbackNote);
+      wd = addWidget(SRC_CITY_TIME, i + 1, W - kPad - labelW, cityY, labelW, labelH,
+                     W - kPad, cityY, TR_DATUM, kFontLabel, kFallbackLabel);
+      setGlyphCells(wd, labelDigitW, labelColonW);
+      addWidget(SRC_CITY_NOTE, i + 1, kPad, noteY, 100, noteH,
+                kPad, noteY, TL_DATUM, kFontNote, kFallbackNote);
     }
   }
 
-  DBG_VERBOSE("Alternate portrait static layout drawn\n");
+  widgetLayout = layout;
+  widgetLayoutWidth = W;
+  DBG_VERBOSE("Widget layout %d: %d widgets\n", layout, widgetCount);
 }
 
-// Update dynamic elements of alternate portrait screen
-void drawAlternatePortraitUpdate() {
-  // CRITICAL: Unload any smooth font from previous screen before drawing anything
-  if (currentSmoothFont != nullptr) {
-    tft.unloadFont();
-    currentSmoothFont = nullptr;
-  }
-
-  time_t now = time(nullptr);
-
-  // Clock constants (top-left position)
-  const int clockCenterX = 60;
-  const int clockCenterY = 80;
-  const int hourHandLen = 28;
-  const int minuteHandLen = 40;
-  const int secondHandLen = 45;
-
-  // === HOME CITY LABEL (Top center) ===
-  struct tm homeTm;
-  getLocalTimeNoSetenv(now, &parsedTz[0], &homeTm);
+// Current text and colour of a widget
+static void widgetContent(const TextWidget &wd, char *out, size_t len, uint16_t *color) {
+  out[0] = '\0';
+  *color = COLOR_TIME;
+  int city = (wd.row == 0) ? 0 : cityForRemoteRow(wd.row - 1);  // -1 = empty row
 
-  // === HOME CITY HEADER ===
-  char homeLabel[48];
-  snprintf(homeLabel, sizeof(homeLabel), "Home: %s", config.homeCityLabel);
+  switch (wd.source) {
+    case SRC_DATE:
+      strlcpy(out, dateText, len);
+      break;
 
-  setFont(kFontLabel, kFallbackLabel);  // Smooth font to match remote cities
-  tft.setTextColor(TFT_CYAN, COLOR_BG);
-  tft.setTextDatum(TC_DATUM);
-  tft.setTextPadding(180);
-  tft.drawString(homeLabel, tft.width() / 2, 4);
+    case SRC_PAGE:
+      if (remotePageCount() > 1) {
+        snprintf(out, len, "%d/%d", remotePage + 1, remotePageCount());
+      }
+      *color = TFT_DARKGREY;
+      break;
+
+    case SRC_CITY_TIME:
+      if (city < 0) break;
+      strlcpy(out, timeCache.timeStr[city], len);
+      if (wd.blink && (time(nullptr) % 2) != 0) {
+        out[2] = ' ';  // Colon shown on even seconds
+      }
+      break;
+
+    case SRC_CITY_LABEL:
+      *color = COLOR_LABEL;
+      if (city == 0) {
+        strlcpy(out, config.homeCityLabel, len);
+      } else if (city > 0) {
+        strlcpy(out, config.remoteCities[city - 1], len);
+      }
+      break;
+
+    case SRC_CITY_NOTE:
+      if (city < 0) break;
+      if (timeCache.prevDay[city]) {
+        strlcpy(out, wd.upperNote ? "PREV DAY" : "Prev Day", len);
+        *color = TFT_YELLOW;
+      } else if (timeCache.nextDay[city]) {
+        strlcpy(out, wd.upperNote ? "NEXT DAY" : "Next Day", len);
+        *color = TFT_CYAN;
+      } else if (city == 0) {
+        strlcpy(out, "HOME", len);
+        *color = TFT_CYAN;
+      }
+      break;
+
+    case SRC_HOME_HEADER:
+      snprintf(out, len, "Home: %s", config.homeCityLabel);
+      *color = TFT_CYAN;
+      break;
+
+    case SRC_TEMPERATURE:
+      // Abbreviated format: T 29oC or T n/a
+      if (sensorAvailable) {
+        int displayTemp = config.useFahrenheit ? (int)(temperature * 9.0 / 5.0 + 32) : (int)temperature;
+        const char* tempUnit = config.useFahrenheit ? "o""F" : "o""C";
+        // Handle negative temperatures (with space after T)
+        if (displayTemp < 0) {
+          snprintf(out, len, "T -%d%s", abs(displayTemp), tempUnit);
+        } else {
+          snprintf(out, len, "T %d%s", displayTemp, tempUnit);
+        }
+        // Color based on temperature (always Celsius for color determination)
+        *color = getTemperatureColor(temperature);
+      } else {
+        strlcpy(out, "T n/a", len);
+        *color = TFT_LIGHTGREY;
+      }
+      break;
 
-  // === ANALOGUE CLOCK (Update hands every second) ===
-  int currentSecond = homeTm.tm_sec;
-  int currentMinute = homeTm.tm_min;
-  int currentHour = homeTm.tm_hour;
+    case SRC_HUMIDITY:
+      // Abbreviated format: H 65% or H n/a
+      *color = TFT_LIGHTGREY;
+      strlcpy(out, "H n/a", len);
+#if defined(USE_BME280) || defined(USE_SHT3X) || defined(USE_HTU21D)
+      if (sensorAvailable) {
+        snprintf(out, len, "H %d%%", (int)humidity);
+      }
+#endif
+      break;
 
-  if (currentSecond != lastSecond || currentMinute != lastMinute || currentHour != lastHour) {
-    // Erase old hands (draw in background color)
-    if (lastSecond >= 0) {
-      float oldSecondAngle = lastSecond * 6.0f;
-      float oldMinuteAngle = lastMinute * 6.0f;
-      float oldHourAngle = (lastHour % 12) * 30.0f + lastMinute * 0.5f;
+    case SRC_PRESSURE:
+      // Abbreviated format: P 1005hPa or P n/a
+      *color = TFT_LIGHTGREY;
+      strlcpy(out, "P n/a", len);
+#if defined(USE_BME280) || defined(USE_BMP280)
+      if (sensorAvailable) {
+        snprintf(out, len, "P %dhPa", (int)pressure);
+      }
+#endif
+      break;
+  }
+}
 
-      drawClockHand(clockCenterX, clockCenterY, secondHandLen, oldSecondAngle, COLOR_BG, 1);
-      drawClockHand(clockCenterX, clockCenterY, minuteHandLen, oldMinuteAngle, COLOR_BG, 2);
-      drawClockHand(clockCenterX, clockCenterY, hourHandLen, oldHourAngle, COLOR_BG, 3);
+// Draw every widget that intersects the area (ax, ay, aw, ah) into gfx,
+// whose pixel (0, 0) is screen (ox, oy). Cached time glyphs are copied
+// straight into pixels (gfx's buffer, width aw; nullptr for the panel);
+// the rest is drawn one font at a time, starting with the font gfx already
+// has loaded.
+static void paintWidgets(TFT_eSPI &gfx, const char *&loadedFont, uint16_t *pixels,
+                         int ax, int ay, int aw, int ah, int ox, int oy) {
+  bool pending[kMaxWidgets];
+  int remaining = 0;
+  for (int i = 0; i < widgetCount; i++) {
+    const TextWidget &wd = widgets[i];
+    pending[i] = wd.text[0] != '\0' &&
+                 wd.x < ax + aw && ax < wd.x + wd.w && wd.y < ay + ah && ay < wd.y + wd.h;
+    if (!pending[i]) continue;
+
+    GlyphCache *gc = (pixels != nullptr && wd.digitW > 0) ? findGlyphCache(wd) : nullptr;
+    if (gc != nullptr) {
+      blitGlyphCells(wd, *gc, pixels, aw, max((int)wd.x, ax), max((int)wd.y, ay),
+                     min(wd.x + wd.w, ax + aw), min(wd.y + wd.h, ay + ah), ox, oy);
+      pending[i] = false;
+    } else {
+      remaining++;
     }
-
-    // Draw new hands
-    float secondAngle = currentSecond * 6.0f;
-    float minuteAngle = currentMinute * 6.0f;
-    float hourAngle = (currentHour % 12) * 30.0f + currentMinute * 0.5f;
-
-    drawClockHand(clockCenterX, clockCenterY, hourHandLen, hourAngle, TFT_WHITE, 3);
-    drawClockHand(clockCenterX, clockCenterY, minuteHandLen, minuteAngle, TFT_WHITE, 2);
-    drawClockHand(clockCenterX, clockCenterY, secondHandLen, secondAngle, TFT_RED, 1);
-
-    // Center dot
-    tft.fillCircle(clockCenterX, clockCenterY, 3, TFT_WHITE);
-
-    lastSecond = currentSecond;
-    lastMinute = currentMinute;
-    lastHour = currentHour;
   }
 
-  // === HOME TIME + ENVIRONMENTAL DATA (Right side, centered on clock axis) ===
-
-  // === HOME CITY DIGITAL TIME (Right side, top, centered) ===
-  TimeInfo homeInfo = formatTime(0);
-  bool timeChanged = (strcmp(homeInfo.timeStr, lastTimes[0]) != 0);
-  bool colonChanged = (homeInfo.showColon != lastColonState[0]);
-
-  if (timeChanged || colonChanged) {
-    int timeY = 30;
-
-    setFont(kFontTime, kFallbackTime);
-    tft.setTextColor(COLOR_TIME, COLOR_BG);
-    tft.setTextDatum(TC_DATUM);  // Top-center alignment
-    tft.setTextPadding(tft.textWidth("88:88"));
-    tft.drawString(homeInfo.timeStr, 180, timeY);  // Centered on right side
+  while (remaining > 0) {
+    int pick = -1;
+    for (int i = 0; i < widgetCount && pick < 0; i++) {
+      if (pending[i] && widgets[i].font != nullptr && widgets[i].font == loadedFont) pick = i;
+    }
+    for (int i = 0; i < widgetCount && pick < 0; i++) {
+      if (pending[i]) pick = i;
+    }
+    const char *font = widgets[pick].font;
+    uint8_t fallback = widgets[pick].fallback;
+    setFontOn(gfx, loadedFont, font, fallback);
+
+    for (int i = 0; i < widgetCount; i++) {
+      const TextWidget &wd = widgets[i];
+      if (!pending[i] || wd.font != font || wd.fallback != fallback) continue;
+
+      // Clip to the widget box within the area
+      int cx0 = max((int)wd.x, ax);
+      int cy0 = max((int)wd.y, ay);
+      int cx1 = min(wd.x + wd.w, ax + aw);
+      int cy1 = min(wd.y + wd.h, ay + ah);
+      gfx.setTextColor(wd.color, COLOR_BG);
+      gfx.setTextPadding(0);
+      if (wd.digitW > 0) {
+        // One glyph per cell, centred; only the cells inside the area
+        gfx.setTextDatum(TC_DATUM);
+        for (int g = 0; g < 5 && wd.text[g] != '\0'; g++) {
+          int gx, gw;
+          glyphCell(wd, g, &gx, &gw);
+          int gx0 = max(gx, cx0);
+          int gx1 = min(gx + gw, cx1);
+          if (wd.text[g] == ' ' || gx0 >= gx1) continue;
+          char glyph[2] = {wd.text[g], '\0'};
+          gfx.setViewport(gx0 - ox, cy0 - oy, gx1 - gx0, cy1 - cy0, false);
+          gfx.drawString(glyph, gx + gw / 2 - ox, wd.ty - oy);
+        }
+      } else {
+        gfx.setViewport(cx0 - ox, cy0 - oy, cx1 - cx0, cy1 - cy0, false);
+        gfx.setTextDatum(wd.datum);
+        gfx.drawString(wd.text, wd.tx - ox, wd.ty - oy);
+      }
 
-    strlcpy(lastTimes[0], homeInfo.timeStr, sizeof(lastTimes[0]));
-    lastColonState[0] = homeInfo.showColon;
+      pending[i] = false;
+      remaining--;
+    }
   }
+  gfx.resetViewport();
+}
 
-  // === ENVIRONMENTAL DATA (Right side, below home time) ===
-  int sensorX = 130;
-  int sensorYStart = 70;  // Below home time, moved down to avoid overlap
-
-  // CRITICAL: Unload smooth font and switch to environmental data font
-  if (currentSmoothFont != nullptr) {
-    tft.unloadFont();
-    currentSmoothFont = nullptr;
+// Sprite of exactly w x h from the pool (LRU replacement), or nullptr if
+// the buffer can't be allocated
+static ComposeSlot *acquireComposeSlot(int w, int h) {
+  static uint32_t useCounter = 0;
+  ComposeSlot *slot = &composePool[0];
+  for (int i = 0; i < COMPOSE_POOL_SIZE; i++) {
+    if (composePool[i].width == w && composePool[i].height == h) {
+      composePool[i].lastUsed = ++useCounter;
+      return &composePool[i];
+    }
+    if (composePool[i].lastUsed < slot->lastUsed) {
+      slot = &composePool[i];
+    }
   }
-  // Use medium smooth font for readable display, centered alignment
-  setFont(kFontLabel, kFallbackLabel);
-  tft.setTextDatum(TC_DATUM);  // Top-center alignment
-  int centerX = 180;  // Center on right side (align with home time)
-  tft.setTextPadding(tft.textWidth("P 8888hPa"));  // Enough for widest string
 
-  // Temperature (abbreviated format: T 29oC or T n/a)
-  char tempStr[16];
-  if (sensorAvailable) {
-    int displayTemp = config.useFahrenheit ? (int)(temperature * 9.0 / 5.0 + 32) : (int)temperature;
-    const char* tempUnit = config.useFahrenheit ? "o""F" : "o""C";
+  // The loaded font survives: it is sprite state, not buffer
+  slot->sprite.deleteSprite();
+  slot->width = 0;
+  slot->height = 0;
+  slot->sprite.setColorDepth(16);
+  if (slot->sprite.createSprite(w, h) == nullptr) {
+    DBG_WARN("Compose sprite %dx%d failed (heap %u)\n", w, h, ESP.getFreeHeap());
+    return nullptr;
+  }
+  slot->width = w;
+  slot->height = h;
+  slot->lastUsed = ++useCounter;
+  return slot;
+}
 
-    // Handle negative temperatures (with space after T)
-    if (displayTemp < 0) {
-      snprintf(tempStr, sizeof(tempStr), "T -%d%s", abs(displayTemp), tempUnit);
-    } else {
-      snprintf(tempStr, sizeof(tempStr), "T %d%s", displayTemp, tempUnit);
+// Repaint one merged rect: in horizontal pieces of at most
+// COMPOSE_MAX_PIXELS, each composed in a sprite and pushed as one window
+static void composeRect(const DamageRect &r) {
+  int rw = r.x1 - r.x0;
+  int rh = r.y1 - r.y0;
+  int maxRows = max(1, COMPOSE_MAX_PIXELS / rw);
+  int pieces = (rh + maxRows - 1) / maxRows;
+  int pieceRows = (rh + pieces - 1) / pieces;  // Equal pieces share one slot
+
+  for (int py = r.y0; py < r.y1; py += pieceRows) {
+    int rows = min(pieceRows, r.y1 - py);
+    ComposeSlot *slot = acquireComposeSlot(rw, pieceRows);
+    if (slot == nullptr) {
+      // No sprite memory: clear and draw straight to the panel
+      composeFallbacks++;
+      tft.fillRect(r.x0, py, rw, rows, COLOR_BG);
+      paintWidgets(tft, currentSmoothFont, nullptr, r.x0, py, rw, rows, 0, 0);
+      framePixels += (uint32_t)rw * rows;
+      frameWindows++;
+      continue;
     }
 
-    // Get color based on temperature (always use Celsius for color determination)
-    uint16_t tempColor = getTemperatureColor(temperature);
-    tft.setTextColor(tempColor, COLOR_BG);
-  } else {
-    snprintf(tempStr, sizeof(tempStr), "T n/a");
-    tft.setTextColor(TFT_LIGHTGREY, COLOR_BG);
+    TFT_eSprite &spr = slot->sprite;
+    spr.fillSprite(COLOR_BG);
+    paintWidgets(spr, slot->font, (uint16_t *)spr.getPointer(), r.x0, py, rw, rows, r.x0, py);
+    spr.pushSprite(r.x0, py, 0, 0, rw, rows);  // Full-width source: one window
+    framePixels += (uint32_t)rw * rows;
+    frameWindows++;
   }
-  tft.drawString(tempStr, centerX, sensorYStart);
+}
 
-  // Humidity (abbreviated format: H 65% or H n/a)
-  char humStr[16];
-  tft.setTextColor(TFT_LIGHTGREY, COLOR_BG);
-#if defined(USE_BME280) || defined(USE_SHT3X) || defined(USE_HTU21D)
-  if (sensorAvailable) {
-    snprintf(humStr, sizeof(humStr), "H %d%%", (int)humidity);
-  } else {
-    snprintf(humStr, sizeof(humStr), "H n/a");
+// One frame: refresh every widget of the current screen and flush the damage.
+// Uses cached time values - NO setenv() calls
+void renderWidgets() {
+  ScopedRenderTimer timer(RT_WIDGETS);
+  uint32_t start = micros();
+  if (!timeCacheInitialized) {
+    updateAllCityTimes();
   }
-#else
-  snprintf(humStr, sizeof(humStr), "H n/a");
-#endif
-  tft.drawString(humStr, centerX, sensorYStart + 18);  // More spacing for larger font
 
-  // Pressure (abbreviated format: P 1005hPa or P n/a)
-  char presStr[16];
-  tft.setTextColor(TFT_LIGHTGREY, COLOR_BG);
-#if defined(USE_BME280) || defined(USE_BMP280)
-  if (sensorAvailable) {
-    snprintf(presStr, sizeof(presStr), "P %dhPa", (int)pressure);
-  } else {
-    snprintf(presStr, sizeof(presStr), "P n/a");
+  WidgetLayout layout = activeWidgetLayout();
+  if (layout != widgetLayout || widgetLayoutWidth != tft.width()) {
+    buildWidgetLayout(layout);
   }
-#else
-  snprintf(presStr, sizeof(presStr), "P n/a");
-#endif
-  tft.drawString(presStr, centerX, sensorYStart + 36);  // More spacing for larger font
-
-  // === REMOTE CITIES (Compact format) ===
-  // PERFORMANCE OPTIMIZATION: Batch drawing by font type to minimize font switching
-  // Instead of switching fonts for each city (10 switches), we draw in passes (2 switches total)
-
-  // First, collect what needs to be drawn for each city
-  struct CityDrawInfo {
-    bool needsUpdate;
-    int rowY;
-    int cityY;
-    int cityFontHeight;
-    TimeInfo info;
-    bool isPrevDay;
-    bool isNextDay;
-  };
-  CityDrawInfo cityDrawInfo[5];
 
-  for (int i = 0; i < 5; i++) {
-    int cityIdx = i + 1;
-    cityDrawInfo[i].rowY = 137 + (i * 37);
-    cityDrawInfo[i].cityY = cityDrawInfo[i].rowY + 4;
-
-    TimeInfo remoteInfo = formatTime(cityIdx);
-    bool remoteTimeChanged = (strcmp(remoteInfo.timeStr, lastTimes[cityIdx]) != 0);
-    bool remoteColonChanged = (remoteInfo.showColon != lastColonState[cityIdx]);
-
-    // Get day comparison for prev/next day indicators
-    struct tm remoteTm;
-    getLocalTimeNoSetenv(now, &parsedTz[cityIdx], &remoteTm);
-    bool isPrevDay = (remoteTm.tm_year < homeTm.tm_year) ||
-                     (remoteTm.tm_year == homeTm.tm_year && remoteTm.tm_yday < homeTm.tm_yday);
-    bool isNextDay = (remoteTm.tm_year > homeTm.tm_year) ||
-                     (remoteTm.tm_year == homeTm.tm_year && remoteTm.tm_yday > homeTm.tm_yday);
-
-    bool dayChanged = (isPrevDay != lastPrevDay[cityIdx]) || (isNextDay != lastNextDay[cityIdx]);
-
-    cityDrawInfo[i].needsUpdate = (remoteTimeChanged || remoteColonChanged || dayChanged);
-    cityDrawInfo[i].info = remoteInfo;
-    cityDrawInfo[i].isPrevDay = isPrevDay;
-    cityDrawInfo[i].isNextDay = isNextDay;
-
-    // Update cache
-    if (cityDrawInfo[i].needsUpdate) {
-      strlcpy(lastTimes[cityIdx], remoteInfo.timeStr, sizeof(lastTimes[cityIdx]));
-      lastColonState[cityIdx] = remoteInfo.showColon;
-      lastPrevDay[cityIdx] = isPrevDay;
-      lastNextDay[cityIdx] = isNextDay;
+  for (int i = 0; i < widgetCount; i++) {
+    TextWidget &wd = widgets[i];
+    char text[sizeof(wd.text)];
+    uint16_t color;
+    widgetContent(wd, text, sizeof(text), &color);
+    if (wd.valid && wd.color == color && strcmp(wd.text, text) == 0) continue;
+
+    // After a static repaint an empty box is already blank
+    bool blank = !wd.valid && text[0] == '\0';
+    bool cellsOnly = wd.valid && wd.digitW > 0 && wd.color == color &&
+                     strlen(wd.text) == 5 && strlen(text) == 5;
+    if (cellsOnly) {
+      // Same colour, both HH:MM: damage just the glyphs that differ
+      for (int g = 0; g < 5; g++) {
+        if (wd.text[g] == text[g]) continue;
+        int gx, gw;
+        glyphCell(wd, g, &gx, &gw);
+        markDamage(gx, wd.y, gw, wd.h);
+      }
+    } else if (!blank) {
+      markDamage(wd.x, wd.y, wd.w, wd.h);
     }
+    strlcpy(wd.text, text, sizeof(wd.text));
+    wd.color = color;
+    wd.valid = true;
   }
 
-  // PASS 1: Draw city names with kFontNote (already loaded above for env data)
-  setFont(kFontNote, kFallbackNote);
-  int cityFontHeight = tft.fontHeight();  // Get font height once
-  tft.setTextColor(COLOR_LABEL, COLOR_BG);
-  tft.setTextDatum(TL_DATUM);
-  tft.setTextPadding(120);
-
-  for (int i = 0; i < 5; i++) {
-    if (cityDrawInfo[i].needsUpdate) {
-      tft.drawString(config.remoteCities[i], kPad, cityDrawInfo[i].cityY);
-      cityDrawInfo[i].cityFontHeight = cityFontHeight;
-    }
+  framePixels = 0;
+  frameWindows = 0;
+  for (int i = 0; i < damageCount; i++) {
+    composeRect(damageRects[i]);
   }
+  damageCount = 0;
+
+  frameBytes = framePixels * 2 + frameWindows * kWindowSetupBytes;
+  layoutFrames[layout]++;
+  layoutBytes[layout] += frameBytes;
+  frameCount++;
+  frameTotalPixels += framePixels;
+  if (framePixels > frameMaxPixels) frameMaxPixels = framePixels;
+  frameLastUs = micros() - start;
+}
 
-  // PASS 2: Draw times with kFontLabel (one font switch)
-  setFont(kFontLabel, kFallbackLabel);
-  tft.setTextColor(COLOR_TIME, COLOR_BG);
-  tft.setTextDatum(TR_DATUM);
-  tft.setTextPadding(tft.textWidth("88:88"));
+// Advance to the next page of remote cities. The row widgets pick up the
+// new cities on the next frame and repaint only what differs.
+void flipRemotePage() {
+  remotePage = (remotePage + 1) % remotePageCount();
+  DBG_VERBOSE("Remote page %d/%d\n", remotePage + 1, remotePageCount());
+}
 
-  for (int i = 0; i < 5; i++) {
-    if (cityDrawInfo[i].needsUpdate) {
-      tft.drawString(cityDrawInfo[i].info.timeStr, tft.width() - kPad, cityDrawInfo[i].rowY + 4);
-    }
+// Draw times for each location and update only when needed.
+void drawTimes() {
+  ScopedRenderTimer timer(config.landscapeMode ? RT_TIMES_LANDSCAPE : RT_TIMES_PORTRAIT);
+  if (config.landscapeMode) {
+    // Analog clock hands follow the home city (every second)
+    updateClockNow(landscapeClock);
   }
+  renderWidgets();
+}
 
-  // PASS 3: Draw day indicators with kFontNote (one font switch)
-  setFont(kFontNote, kFallbackNote);
-  tft.setTextDatum(TL_DATUM);
-  tft.setTextPadding(100);
-
-  for (int i = 0; i < 5; i++) {
-    if (cityDrawInfo[i].needsUpdate) {
-      if (cityDrawInfo[i].isPrevDay) {
-        tft.setTextColor(TFT_YELLOW, COLOR_BG);
-        tft.drawString("Prev Day", kPad, cityDrawInfo[i].cityY + cityDrawInfo[i].cityFontHeight + 2);
-      } else if (cityDrawInfo[i].isNextDay) {
-        tft.setTextColor(TFT_CYAN, COLOR_BG);
-        tft.drawString("Next Day", kPad, cityDrawInfo[i].cityY + cityDrawInfo[i].cityFontHeight + 2);
-      } else {
-        // Clear indicator if day matches
-        tft.fillRect(kPad, cityDrawInfo[i].cityY + cityDrawInfo[i].cityFontHeight + 2, 100, 10, COLOR_BG);
-      }
-    }
-  }
+// =========================
+// Alternate Portrait Screen (with Analogue Clock + Environmental Data)
+// =========================
+// This screen alternates with the standard portrait screen when environmental
+// sensor is available and screen rotation is enabled.
+//
+// Layout (240x320):
+// - Header: "Home: CITYNAME" centered (y=4)
+// - Home time: Large, centered on right side (y=30)
+// - Analogue clock (left, center at 60,80) + Sensor data (right, y=70-98)
+// - Clock bottom edge at y=135 (no cropping)
+// - Sensor data always shown (Temp, Hum, Press) with "n/a" when unavailable
+// - Remote cities: 2-line format (y=137-320, 5 cities × 37px)
+// - Day indicators ("Prev Day"/"Next Day") directly below city name, no indent
+// - No separator lines between cities
+
+// Draw static layout for alternate portrait screen (painted in bands, see
+// submitStaticLayout)
+void drawAlternatePortraitStatic() {
+  submitStaticLayout(LAYER_ALTERNATE);
+}
+
+// Update dynamic elements of alternate portrait screen
+void drawAlternatePortraitUpdate() {
+  ScopedRenderTimer timer(RT_ALTERNATE);
+  // === ANALOGUE CLOCK (hands follow the home time) ===
+  updateClockNow(alternateClock);
+
+  // Header, home time, sensor lines and remote rows are widgets
+  renderWidgets();
 
   DBG_VERBOSE("Alternate portrait screen updated\n");
 }
@@ -1771,9 +2790,10 @@ static void displayWiFiSetupInstructions(const char* apName, const char* ipAddre
   tft.setTextDatum(TC_DATUM);
 
   // Title
+  static constexpr char kTitle[] = "WiFi SETUP";
   setFont("NotoSans-Bold16", 4);
   tft.setTextColor(TFT_CYAN, TFT_BLACK);
-  tft.drawString("WiFi SETUP", tft.width() / 2, 20);
+  tft.drawString(kTitle, tft.width() / 2, 20);
 
   // Instructions
   setFont("NotoSans-Bold10", 2);
@@ -1883,7 +2903,9 @@ static void setupOTA() {
   ArduinoOTA.setPassword(OTA_PASSWORD);
 
   ArduinoOTA.onStart([]() {
+    otaActive = true;
     DBG_INFO("OTA: Update starting...\n");
+    abortStaticLayout();
     tft.fillScreen(TFT_BLACK);
     tft.setTextDatum(MC_DATUM);
     tft.setTextColor(TFT_CYAN, TFT_BLACK);
@@ -1908,6 +2930,7 @@ static void setupOTA() {
   });
 
   ArduinoOTA.onEnd([]() {
+    otaActive = false;
     DBG_INFO("OTA: Update complete!\n");
     tft.fillScreen(TFT_BLACK);
     tft.setTextDatum(MC_DATUM);
@@ -1917,6 +2940,7 @@ static void setupOTA() {
   });
 
   ArduinoOTA.onError([](ota_error_t error) {
+    otaActive = false;
     DBG_ERROR("OTA Error[%u]: ", error);
     tft.fillScreen(TFT_BLACK);
     tft.setTextColor(TFT_RED, TFT_BLACK);
@@ -1959,6 +2983,91 @@ void handleGetState() {
   doc["enableScreenRotation"] = config.enableScreenRotation;
   doc["screenFlipInterval"] = config.screenFlipInterval;
   doc["showingAlternateScreen"] = showingAlternateScreen;
+  doc["loopWakeups"] = loopWakeups;
+  doc["loopCpuPct"] = loopCpuUs / 10000.0f;  // Loop busy share of the last second
+
+  // Sub-second time source: SNTP updates and second-tick alignment
+  JsonObject wallClock = doc["wallClock"].to<JsonObject>();
+  wallClock["ntpSyncs"] = ntpSyncs;
+  wallClock["lastSync"] = (uint32_t)lastNtpSync;
+  wallClock["tickLateUs"] = tickLateUs;
+  wallClock["maxTickLateUs"] = tickLateMaxUs;
+  doc["tzdbZones"] = tzdbZoneCount();
+  doc["tzdbReads"] = tzdbFileReads();
+
+  // Widget compositor cost (last frame, plus max/average since boot)
+  JsonObject frame = doc["frame"].to<JsonObject>();
+  frame["count"] = frameCount;
+  frame["pixels"] = framePixels;
+  frame["windows"] = frameWindows;
+  frame["maxPixels"] = frameMaxPixels;
+  frame["avgPixels"] = frameCount ? frameTotalPixels / frameCount : 0;
+  frame["us"] = frameLastUs;
+  frame["fallbacks"] = composeFallbacks;
+  frame["bytes"] = frameBytes;
+  frame["glyphCacheBytes"] = glyphCacheBytes;
+  frame["glyphBlits"] = glyphCacheBlits;
+  frame["glyphCacheSkipped"] = glyphCacheSkipped;
+
+  // Analogue clock hand update per second tick (erase + redraw)
+  JsonObject hands = doc["clockHands"].to<JsonObject>();
+  hands["restoredPixels"] = clockRestoredPixels;
+  hands["ticks"] = handTicks;
+  hands["lastUs"] = handTickLastUs;
+  hands["maxUs"] = handTickMaxUs;
+  hands["avgUs"] = handTicks ? handTickTotalUs / handTicks : 0;
+  hands["sweep"] = (bool)CLOCK_SWEEP_ENABLED;
+  hands["targetFps"] = CLOCK_FRAMES_ENABLED ? 1000000 / kClockFrameUs : 1;
+  hands["fps"] = clockFps;  // Frames drawn in the last second
+  hands["cpuPct"] = clockCpuUs / 10000.0f;
+
+  // Anti-aliased sprite clock: render + push per frame
+  JsonObject clockSpr = doc["clockSprite"].to<JsonObject>();
+  clockSpr["enabled"] = (bool)CLOCK_SPRITE_ENABLED;
+  clockSpr["fps"] = CLOCK_SPRITE_FPS;
+  clockSpr["frames"] = clockFrames;
+  clockSpr["renderUs"] = clockRenderLastUs;
+  clockSpr["pushUs"] = clockPushLastUs;
+  clockSpr["avgRenderUs"] = clockFrames ? clockRenderTotalUs / clockFrames : 0;
+  clockSpr["avgPushUs"] = clockFrames ? clockPushTotalUs / clockFrames : 0;
+  clockSpr["maxFrameUs"] = clockFrameMaxUs;
+  clockSpr["fallbacks"] = clockSpriteFallbacks;
+
+  // Smooth font loads (compiled-in fonts: no filesystem access)
+  JsonObject fonts = doc["fonts"].to<JsonObject>();
+  fonts["compiled"] = kCompiledFontCount;
+  fonts["loads"] = fontLoads;
+  fonts["loadUs"] = fontLoadMicros;
+  fonts["lastUs"] = fontLoadLastUs;
+  // Average SPI bytes per frame (= per second) in each screen mode
+  JsonObject perSec = frame["bytesPerSec"].to<JsonObject>();
+  const char *const layoutNames[WL_COUNT] = {nullptr, "portrait", "landscape", "alternate"};
+  for (int l = WL_PORTRAIT; l < WL_COUNT; l++) {
+    perSec[layoutNames[l]] = layoutFrames[l] ? (uint32_t)(layoutBytes[l] / layoutFrames[l]) : 0;
+  }
+
+  // Static layout redraws (banded DMA)
+  JsonObject redraw = doc["staticRedraw"].to<JsonObject>();
+  redraw["dma"] = dmaReady;
+  redraw["count"] = staticRedraws;
+  redraw["bands"] = staticBands;
+  redraw["lastUs"] = staticLastUs;
+  redraw["maxLoopUs"] = staticLoopMaxUs;
+  redraw["slides"] = slideCount;
+  redraw["slideFallbacks"] = slideFallbacks;
+  redraw["slideLastMs"] = slideLastMs;
+  redraw["cacheHits"] = staticCacheHits;
+  redraw["cacheCaptures"] = staticCacheCaptures;
+  redraw["cacheOverflows"] = staticCacheOverflows;
+  redraw["cacheBytes"] = staticCacheBytes();
+
+  // Live diagnostics screen
+  JsonObject diag = doc["diagnostics"].to<JsonObject>();
+  diag["open"] = showingDiagnostics;
+  diag["refreshes"] = diagRefreshes;
+  diag["linesDrawn"] = diagLinesDrawn;
+  diag["logLines"] = diagLogLines;
+  diag["logScrolls"] = diagLogScrolls;
 
   // Environmental sensor data
   doc["sensorAvailable"] = sensorAvailable;
@@ -1987,8 +3096,9 @@ void handleGetState() {
   homeCity["tz"] = config.homeCityTz;
 
   // Remote cities config
+  doc["maxRemoteCities"] = MAX_REMOTE_CITIES;
   JsonArray remoteCities = doc["remoteCities"].to<JsonArray>();
-  for (int i = 0; i < 5; i++) {
+  for (int i = 0; i < config.remoteCount; i++) {
     JsonObject city = remoteCities.add<JsonObject>();
     city["label"] = config.remoteCities[i];
     city["tz"] = config.remoteTzStrings[i];
@@ -2076,7 +3186,7 @@ void handlePostConfig() {
     JsonArray cities = doc["remoteCities"].as<JsonArray>();
     int i = 0;
     for (JsonVariant city : cities) {
-      if (i >= 5) break;
+      if (i >= MAX_REMOTE_CITIES) break;
 
       if (!city["label"].isNull()) {
         const char* label = city["label"];
@@ -2091,6 +3201,10 @@ void handlePostConfig() {
       }
       i++;
     }
+    // Fewer than the minimum keeps the existing trailing slots
+    config.remoteCount = max(i, MIN_REMOTE_CITIES);
+    remotePage = 0;
+    DBG_INFO("  Remote cities: %u\n", config.remoteCount);
   }
 
   // Parse display orientation
@@ -2153,23 +3267,17 @@ void handlePostConfig() {
     applyRotation();
   }
 
-  // Redraw static layout with new city labels
-  drawStaticLayout();
+  // Redraw static layout (widgets redraw the new city labels); the cached
+  // layers may show the old home city
+  invalidateLayerCaches();
+  if (showingDiagnostics) {
+    closeDiagnosticsScreen();  // The clock replaces a console left open
+  } else {
+    drawStaticLayout();
+  }
 
-  // Reset cached state to force full redraw of times on next loop
-  lastDate[0] = '\0';
-  for (int i = 0; i < 6; i++) {
-    lastTimes[i][0] = '\0';
-    lastPrevDay[i] = false;
-    lastNextDay[i] = false;
-    lastColonState[i] = false;
-  }
-  // Reset analog clock state
-  lastSecond = -1;
-  lastMinute = -1;
-  lastHour = -1;
-  // Force immediate recalculation of time cache (including prevDay/nextDay)
-  lastBatchUpdate = 0;
+  // Immediate recalculation of time cache (including prevDay/nextDay)
+  updateAllCityTimes();
 
   server.send(200, "application/json", "{\"ok\":true}");
   DBG_INFO("Config updated and reloaded\n");
@@ -2214,6 +3322,7 @@ void handleSnapshot() {
   }
 
   // Force display redraw to show colons (match current screen mode)
+  finishStaticLayout();
   if (!config.landscapeMode && showingAlternateScreen) {
     drawAlternatePortraitUpdate();  // Capture alternate portrait screen
   } else {
@@ -2324,18 +3433,22 @@ void handleMirror() {
   // Home city
   JsonObject homeCity = doc["home"].to<JsonObject>();
   homeCity["label"] = config.homeCityLabel;
-  homeCity["time"] = lastTimes[0];
-  homeCity["prevDay"] = lastPrevDay[0];
-  homeCity["nextDay"] = lastNextDay[0];
+  homeCity["time"] = timeCache.timeStr[0];
+  homeCity["prevDay"] = timeCache.prevDay[0];
+  homeCity["nextDay"] = timeCache.nextDay[0];
 
-  // Remote cities
+  // Remote cities on the current page (what the panel shows)
+  doc["page"] = remotePage + 1;
+  doc["pages"] = remotePageCount();
   JsonArray remoteCities = doc["remote"].to<JsonArray>();
-  for (int i = 0; i < 5; i++) {
+  for (int i = 0; i < REMOTE_ROWS_PER_PAGE; i++) {
+    int c = cityForRemoteRow(i);
+    if (c < 0) break;
     JsonObject city = remoteCities.add<JsonObject>();
-    city["label"] = config.remoteCities[i];
-    city["time"] = lastTimes[i + 1];
-    city["prevDay"] = lastPrevDay[i + 1];
-    city["nextDay"] = lastNextDay[i + 1];
+    city["label"] = config.remoteCities[c - 1];
+    city["time"] = timeCache.timeStr[c];
+    city["prevDay"] = timeCache.prevDay[c];
+    city["nextDay"] = timeCache.nextDay[c];
   }
 
   // Environmental sensor data (for landscape mode display)
@@ -2390,34 +3503,174 @@ void handleDebug() {
       default:                levelStr = "???"; break;
     }
 
-    JsonObject log = logs.add<JsonObject>();
-    log["t"] = logBuffer[idx].timestamp;
-    log["l"] = levelStr;
-    log["m"] = logBuffer[idx].message;
+    JsonObject log = logs.add<JsonObject>();
+    log["t"] = logBuffer[idx].timestamp;
+    log["l"] = levelStr;
+    log["m"] = logBuffer[idx].message;
+  }
+
+  String output;
+  serializeJson(doc, output);
+  server.send(200, "application/json", output);
+}
+
+// GET /api/timing - Render timing histograms and draw counters
+// ?buckets=1 adds the raw bucket counts (upper bound us -> count)
+void handleTiming() {
+  DBG_VERBOSE("GET /api/timing\n");
+  bool withBuckets = server.arg("buckets") == "1";
+
+  JsonDocument doc;
+  doc["uptime"] = millis() / 1000;
+  JsonObject timers = doc["timers"].to<JsonObject>();
+  for (int t = 0; t < RT_COUNT; t++) {
+    const LatencyHistogram &h = renderTimers[t];
+    JsonObject timer = timers[kRenderTimerNames[t]].to<JsonObject>();
+    timer["count"] = h.count;
+    timer["p50"] = h.percentile(50);
+    timer["p95"] = h.percentile(95);
+    timer["max"] = h.maxUs;
+    timer["avg"] = h.averageUs();
+    if (withBuckets) {
+      JsonArray buckets = timer["buckets"].to<JsonArray>();
+      for (int b = 0; b < LATENCY_BUCKETS; b++) {
+        if (h.counts[b] == 0) continue;
+        JsonArray pair = buckets.add<JsonArray>();
+        pair.add(latencyBucketMax(b));
+        pair.add(h.counts[b]);
+      }
+    }
+  }
+
+  JsonObject counters = doc["counters"].to<JsonObject>();
+  counters["fontSwitches"] = fontSwitches;
+  counters["fontLoads"] = fontLoads;
+  counters["widgetFrames"] = frameCount;
+  counters["widgetPixels"] = frameTotalPixels;
+  counters["clockRestoredPixels"] = clockRestoredPixels;
+  counters["staticBandPixels"] = staticBands * (uint32_t)tft.width() * DMA_BAND_LINES;
+
+  String output;
+  serializeJson(doc, output);
+  server.send(200, "application/json", output);
+}
+
+// GET /api/timezones - Return list of all available timezones
+// Case-insensitive prefix / substring tests for /api/timezones?q=
+static bool startsWithCI(const char* s, const char* prefix) {
+  for (; *prefix; s++, prefix++) {
+    if (asciiLower(*s) != asciiLower(*prefix)) return false;
+  }
+  return true;
+}
+
+static bool containsCI(const char* s, const char* needle) {
+  for (; *s; s++) {
+    if (startsWithCI(s, needle)) return true;
+  }
+  return false;
+}
+
+// First position in timezoneNameIndex whose name is >= q (binary search)
+static int lowerBoundTimezoneName(const char* q) {
+  int lo = 0;
+  int hi = numTimezones;
+  while (lo < hi) {
+    int mid = (lo + hi) / 2;
+    if (compareNameCI(timezones[timezoneNameIndex.order[mid]].name, q) < 0) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+// Streams rows of [{"id":..,"name":..,"tz":..}] through a small stack buffer
+// (chunked transfer), so no JsonDocument / String holds the whole list.
+struct TimezoneRowWriter {
+  char buf[384];
+  size_t len = 0;
+  int rows = 0;
+
+  void flush() {
+    if (len > 0) {
+      server.sendContent(buf, len);
+      len = 0;
+    }
   }
 
-  String output;
-  serializeJson(doc, output);
-  server.send(200, "application/json", output);
-}
+  void add(int id) {
+    char row[128];
+    int n = snprintf(row, sizeof(row), "%s{\"id\":%d,\"name\":\"%s\",\"tz\":\"%s\"}",
+                     rows ? "," : "", id, timezones[id].name, timezones[id].tzString);
+    if (n <= 0 || n >= (int)sizeof(row)) return;
+    if (len + n > sizeof(buf)) flush();
+    memcpy(buf + len, row, n);
+    len += n;
+    rows++;
+  }
+};
 
-// GET /api/timezones - Return list of all available timezones
+// GET /api/timezones[?q=syd][&limit=10][&offset=0]
+// No q: catalog order (region grouping in the web UI), paged by offset/limit.
+// With q: name prefix matches first (binary search on the flash name index),
+// then other names containing q; limit defaults to 10.
 void handleGetTimezones() {
-  DBG_VERBOSE("GET /api/timezones\n");
-
-  // Size: 102 timezones × (name(40) + tz(64)) = ~10,600 bytes. Use 12KB for safety.
-  JsonDocument doc;
-  JsonArray tzArray = doc.to<JsonArray>();
+  char q[32] = "";
+  if (server.hasArg("q")) {
+    strlcpy(q, server.arg("q").c_str(), sizeof(q));
+  }
+  int limit = server.hasArg("limit") ? server.arg("limit").toInt() : (q[0] ? 10 : numTimezones);
+  int offset = server.hasArg("offset") ? server.arg("offset").toInt() : 0;
+  if (limit < 1 || limit > numTimezones) limit = numTimezones;
+  if (offset < 0) offset = 0;
+  DBG_VERBOSE("GET /api/timezones q='%s' limit=%d offset=%d\n", q, limit, offset);
+
+  server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+  server.send(200, "application/json", "");
+
+  TimezoneRowWriter out;
+  out.buf[0] = '[';
+  out.len = 1;
+  int skip = offset;
+
+  if (!q[0]) {
+    for (int i = offset; i < numTimezones && out.rows < limit; i++) {
+      out.add(i);
+    }
+  } else {
+    // Prefix matches are one contiguous run in the sorted index
+    int first = lowerBoundTimezoneName(q);
+    int last = first;
+    while (last < numTimezones && startsWithCI(timezones[timezoneNameIndex.order[last]].name, q)) {
+      last++;
+    }
+    for (int i = first; i < last && out.rows < limit; i++) {
+      if (skip > 0) {
+        skip--;
+        continue;
+      }
+      out.add(timezoneNameIndex.order[i]);
+    }
 
-  for (int i = 0; i < numTimezones; i++) {
-    JsonObject tz = tzArray.add<JsonObject>();
-    tz["name"] = timezones[i].name;
-    tz["tz"] = timezones[i].tzString;
+    // Then substring matches ("york" -> "New York, USA"), alphabetical
+    for (int i = 0; i < numTimezones && out.rows < limit; i++) {
+      if (i >= first && i < last) continue;
+      const char* name = timezones[timezoneNameIndex.order[i]].name;
+      if (!containsCI(name, q)) continue;
+      if (skip > 0) {
+        skip--;
+        continue;
+      }
+      out.add(timezoneNameIndex.order[i]);
+    }
   }
 
-  String output;
-  serializeJson(doc, output);
-  server.send(200, "application/json", output);
+  if (out.len + 1 > sizeof(out.buf)) out.flush();
+  out.buf[out.len++] = ']';
+  out.flush();
+  server.sendContent("");  // End chunked response
 }
 
 // Setup web server routes
@@ -2432,6 +3685,7 @@ void setupWebServer() {
   server.on("/api/snapshot", HTTP_GET, handleSnapshot);
   server.on("/api/mirror", HTTP_GET, handleMirror);
   server.on("/api/debug", HTTP_GET, handleDebug);
+  server.on("/api/timing", HTTP_GET, handleTiming);
 
   // Handle favicon.ico to prevent LittleFS errors
   server.on("/favicon.ico", HTTP_GET, []() {
@@ -2467,117 +3721,373 @@ void setupWebServer() {
 // Diagnostics Screen Rendering
 // =========================
 
-// Format uptime as HH:MM:SS
-String formatUptime(unsigned long seconds) {
-  unsigned long hours = seconds / 3600;
-  unsigned long minutes = (seconds % 3600) / 60;
-  unsigned long secs = seconds % 60;
-  char buf[16];
-  snprintf(buf, sizeof(buf), "%02lu:%02lu:%02lu", hours, minutes, secs);
-  return String(buf);
+// The screen stays up to date while it is open: loop() calls
+// refreshDiagnosticsScreen() on every wake (at least once a second). Every
+// text line is kept as drawn and sent again only when its text or colour
+// changed, so a refresh usually costs the uptime line. New log entries
+// are appended to the RECENT LOGS area; in portrait that area is a hardware
+// scroll area (VSCRDEF between the fixed header and footer lines), so a new
+// entry is written over the oldest line and the scroll start moves on by
+// one line - the same trick as the portrait slide, without repainting the
+// rest of the log. Landscape (the panel scrolls along its long side, which
+// is then horizontal) and other panel drivers keep the lines in place as a
+// ring instead: a new entry overwrites the oldest line and a marker in the
+// left margin points at the newest. Either way an entry costs one line.
+
+const int kDiagLineHeight = 10;
+const int kDiagMaxLines = 24;     // Fixed lines per page
+const int kDiagLineChars = 48;
+
+struct DiagLine {
+  int16_t y;                      // -1 = not on screen
+  uint16_t color;
+  char text[kDiagLineChars];
+};
+
+static DiagLine diagLines[kDiagMaxLines];
+static int diagLineSlot = 0;      // Next line of the page being rendered
+static bool diagWifiUp = false;   // Network block as drawn (its height differs)
+
+static int diagLogTop = 0;        // First row of the log area
+static int diagLogRows = 0;       // Log lines that fit
+static int diagLogShown = 0;      // Lines filled so far (up to diagLogRows)
+static int diagLogHead = 0;       // Line holding the oldest entry once full
+static uint32_t diagLogSeen = 0;  // logTotal when the log was last drawn
+static bool diagLogScroll = false;  // Log area is a hardware scroll area
+static int diagLogMarked = -1;    // Line with the newest-entry marker (ring only)
+
+// Format uptime as HH:MM:SS, or Nd HH:MM:SS past the first day.
+// A 32-bit second count needs at most 16 bytes ("49710d 06:28:15").
+static void formatUptime(char *buf, size_t len, uint32_t seconds) {
+  unsigned days = seconds / 86400;
+  unsigned hours = (seconds / 3600) % 24;
+  unsigned minutes = (seconds / 60) % 60;
+  unsigned secs = seconds % 60;
+  if (days > 0) {
+    snprintf(buf, len, "%ud %02u:%02u:%02u", days, hours, minutes, secs);
+  } else {
+    snprintf(buf, len, "%02u:%02u:%02u", hours, minutes, secs);
+  }
 }
 
-// Draw full-screen diagnostics overlay
-void drawDiagnosticsScreen() {
-  tft.fillScreen(TFT_BLACK);
+// Compact count or microseconds for the 6-column timing table:
+// 1234, 12k (thousands), 12M (millions)
+static void formatCompact(char *buf, size_t len, uint32_t value) {
+  if (value < 10000) {
+    snprintf(buf, len, "%lu", (unsigned long)value);
+  } else if (value < 10000000) {
+    snprintf(buf, len, "%luk", (unsigned long)(value / 1000));
+  } else {
+    snprintf(buf, len, "%luM", (unsigned long)(value / 1000000));
+  }
+}
 
-  // Force unload any smooth fonts and reset to bitmap font
-  tft.unloadFont();
-  tft.setTextFont(1);  // 6x8 pixel bitmap font
-  tft.setTextSize(1);  // Normal size (not scaled)
-  tft.setTextDatum(TL_DATUM);
-  tft.setTextWrap(false);
+// One line of text at row y over a cleared line, clipped to the line so
+// nothing is left on (or spills into) its neighbours
+static void drawDiagLine(int y, uint16_t color, const char *text) {
+  tft.setViewport(0, y, tft.width(), kDiagLineHeight, false);
+  tft.fillRect(0, y, tft.width(), kDiagLineHeight, TFT_BLACK);
+  tft.setTextColor(color, TFT_BLACK);
+  tft.drawString(text, 10, y);
+  tft.resetViewport();
+  diagLinesDrawn++;
+}
 
-  int y = 6;
-  const int lineHeight = 10;
+// Next line of the page at row y: drawn only if it differs from what is there
+static void diagPrint(int y, uint16_t color, const char *text) {
+  if (diagLineSlot >= kDiagMaxLines) return;
+  DiagLine &line = diagLines[diagLineSlot++];
+  if (line.y == y && line.color == color && strcmp(line.text, text) == 0) return;
 
-  // Title
-  tft.setTextColor(TFT_CYAN, TFT_BLACK);
-  tft.drawString("=== DIAGNOSTICS ===", 10, y);
-  y += lineHeight + 2;
+  line.y = (int16_t)y;
+  line.color = color;
+  strlcpy(line.text, text, sizeof(line.text));
+  drawDiagLine(y, color, text);
+}
+
+// Diagnostics page 2: render timing histograms (microseconds)
+static void drawTimingPage(int y, int lineHeight) {
+  diagPrint(y, TFT_YELLOW, "RENDER TIMING (us):");
+  y += lineHeight;
+
+  char line[kDiagLineChars];
+  snprintf(line, sizeof(line), "%-14s%6s%6s%6s%6s", "", "n", "p50", "p95", "max");
+  diagPrint(y, TFT_DARKGREY, line);
+  y += lineHeight;
+
+  for (int t = 0; t < RT_COUNT; t++) {
+    const LatencyHistogram &h = renderTimers[t];
+    char n[8], p50[8], p95[8], mx[8];
+    formatCompact(n, sizeof(n), h.count);
+    formatCompact(p50, sizeof(p50), h.percentile(50));
+    formatCompact(p95, sizeof(p95), h.percentile(95));
+    formatCompact(mx, sizeof(mx), h.maxUs);
+    snprintf(line, sizeof(line), "%-14s%6s%6s%6s%6s", kRenderTimerNames[t], n, p50, p95, mx);
+    diagPrint(y, TFT_WHITE, line);
+    y += lineHeight;
+  }
+  y += 2;
+
+  diagPrint(y, TFT_YELLOW, "COUNTERS:");
+  y += lineHeight;
+
+  char a[8], b[8];
+  formatCompact(a, sizeof(a), fontSwitches);
+  formatCompact(b, sizeof(b), fontLoads);
+  snprintf(line, sizeof(line), "Font switches:%s loads:%s", a, b);
+  diagPrint(y, TFT_WHITE, line);
+  y += lineHeight;
+  formatCompact(a, sizeof(a), frameCount);
+  formatCompact(b, sizeof(b), frameTotalPixels);
+  snprintf(line, sizeof(line), "Widget frames:%s px:%s", a, b);
+  diagPrint(y, TFT_WHITE, line);
+  y += lineHeight;
+  formatCompact(a, sizeof(a), clockRestoredPixels);
+  snprintf(line, sizeof(line), "Clock face px restored:%s", a);
+  diagPrint(y, TFT_WHITE, line);
+}
+
+// Diagnostics page 1: system and network lines; returns the first row
+// below them (the log area)
+static int drawSystemPage(int y, int lineHeight) {
+  char line[kDiagLineChars];
 
   // System Info
-  tft.setTextColor(TFT_YELLOW, TFT_BLACK);
-  tft.drawString("SYSTEM:", 10, y);
+  diagPrint(y, TFT_YELLOW, "SYSTEM:");
   y += lineHeight;
 
-  tft.setTextColor(TFT_WHITE, TFT_BLACK);
-  tft.drawString("FW:" + String(FIRMWARE_VERSION) + " Heap:" + String(ESP.getFreeHeap() / 1024) + "K", 10, y);
+  snprintf(line, sizeof(line), "FW:%s Heap:%luK", FIRMWARE_VERSION, (unsigned long)(ESP.getFreeHeap() / 1024));
+  diagPrint(y, TFT_WHITE, line);
   y += lineHeight;
 
-  tft.drawString("Up:" + formatUptime(millis() / 1000) + " Dbg:" + String(debugLevel), 10, y);
+  char uptime[16];
+  formatUptime(uptime, sizeof(uptime), (uint32_t)(millis() / 1000));
+  snprintf(line, sizeof(line), "Up:%s Dbg:%d", uptime, (int)debugLevel);
+  diagPrint(y, TFT_WHITE, line);
   y += lineHeight + 2;
 
   // WiFi Info
-  tft.setTextColor(TFT_YELLOW, TFT_BLACK);
-  tft.drawString("NETWORK:", 10, y);
+  diagPrint(y, TFT_YELLOW, "NETWORK:");
   y += lineHeight;
 
-  tft.setTextColor(TFT_WHITE, TFT_BLACK);
-  if (WiFi.isConnected()) {
-    String ssid = WiFi.SSID();
-    if (ssid.length() > 20) ssid = ssid.substring(0, 20);
-    tft.drawString("SSID: " + ssid, 10, y);
+  if (diagWifiUp) {
+    snprintf(line, sizeof(line), "SSID: %.20s", cachedSSID);
+    diagPrint(y, TFT_WHITE, line);
     y += lineHeight;
 
-    tft.setTextColor(TFT_GREEN, TFT_BLACK);
-    tft.drawString("IP: " + WiFi.localIP().toString() + "  RSSI: " + String(WiFi.RSSI()) + "dBm", 10, y);
+    snprintf(line, sizeof(line), "IP: %s  RSSI: %ddBm", cachedIP, (int)WiFi.RSSI());
+    diagPrint(y, TFT_GREEN, line);
     y += lineHeight + 2;
   } else {
-    tft.setTextColor(TFT_RED, TFT_BLACK);
-    tft.drawString("Not connected", 10, y);
+    diagPrint(y, TFT_RED, "Not connected");
     y += lineHeight + 2;
   }
 
   // Log entries
-  tft.setTextColor(TFT_YELLOW, TFT_BLACK);
-  tft.drawString("RECENT LOGS:", 10, y);
-  y += lineHeight;
+  diagPrint(y, TFT_YELLOW, "RECENT LOGS:");
+  return y + lineHeight;
+}
 
-  // Calculate how many logs can fit
-  int remainingHeight = tft.height() - y - 12;
-  int maxLogs = remainingHeight / lineHeight;
-  if (maxLogs > logCount) maxLogs = logCount;
-  if (maxLogs > LOG_BUFFER_SIZE) maxLogs = LOG_BUFFER_SIZE;
+// Entry `back` places before the newest (1 = newest)
+static const LogEntry &recentLog(int back) {
+  return logBuffer[(logIndex - back + LOG_BUFFER_SIZE) % LOG_BUFFER_SIZE];
+}
 
-  // Display most recent logs (circular buffer)
-  for (int i = 0; i < maxLogs; i++) {
-    int idx = (logIndex - maxLogs + i + LOG_BUFFER_SIZE) % LOG_BUFFER_SIZE;
-    if (idx < 0) idx += LOG_BUFFER_SIZE;
+// One log entry into log area line `row`: MM:SS and the message, truncated
+// to fit the screen (wider with small font), coloured by level
+static void drawLogLine(int row, const LogEntry &entry) {
+  uint16_t color;
+  switch (entry.level) {
+    case DBG_LEVEL_ERROR:   color = TFT_RED; break;
+    case DBG_LEVEL_WARN:    color = TFT_YELLOW; break;
+    case DBG_LEVEL_VERBOSE: color = TFT_DARKGREY; break;
+    default:                color = TFT_WHITE; break;
+  }
 
-    // Color by level
-    uint16_t color;
-    switch (logBuffer[idx].level) {
-      case DBG_LEVEL_ERROR:   color = TFT_RED; break;
-      case DBG_LEVEL_WARN:    color = TFT_YELLOW; break;
-      case DBG_LEVEL_VERBOSE: color = TFT_DARKGREY; break;
-      default:                color = TFT_WHITE; break;
-    }
+  unsigned long secs = entry.timestamp / 1000;
+  unsigned long mins = secs / 60;
+  secs = secs % 60;
+  char line[kDiagLineChars];
+  if (strlen(entry.message) > 32) {
+    snprintf(line, sizeof(line), "%02lu:%02lu %.29s...", mins % 100, secs, entry.message);
+  } else {
+    snprintf(line, sizeof(line), "%02lu:%02lu %s", mins % 100, secs, entry.message);
+  }
+
+  drawDiagLine(diagLogTop + row * kDiagLineHeight, color, line);
+}
+
+// Ring without a scroll area: move the newest-entry marker to line `row`
+static void markNewestLog(int row) {
+  if (diagLogScroll) return;
+  if (diagLogMarked >= 0 && diagLogMarked != row) {
+    tft.fillRect(0, diagLogTop + diagLogMarked * kDiagLineHeight, 8, kDiagLineHeight, TFT_BLACK);
+  }
+  int y = diagLogTop + row * kDiagLineHeight;
+  tft.fillTriangle(2, y, 2, y + 6, 5, y + 3, TFT_CYAN);
+  diagLogMarked = row;
+}
 
-    tft.setTextColor(color, TFT_BLACK);
+// The most recent entries that fit, oldest first from the top line
+static void drawLogArea() {
+  int count = min(logCount, diagLogRows);
+  for (int row = 0; row < count; row++) {
+    drawLogLine(row, recentLog(count - row));
+  }
+  diagLogShown = count;
+  diagLogHead = 0;
+  diagLogSeen = logTotal;
+  diagLogMarked = -1;
+  if (count > 0) markNewestLog(count - 1);
+}
+
+#if PANEL_SCROLL_SUPPORTED
+// Memory line of the log area's top: portrait rotation 2 stores rows
+// bottom-up, so the area starts that far from the other end of memory
+static uint16_t diagScrollTop() {
+  int lines = diagLogRows * kDiagLineHeight;
+  return (uint16_t)((tft.getRotation() == 2) ? TFT_HEIGHT - diagLogTop - lines : diagLogTop);
+}
 
-    // Format timestamp as MM:SS
-    unsigned long secs = logBuffer[idx].timestamp / 1000;
-    unsigned long mins = secs / 60;
-    secs = secs % 60;
-    char timeBuf[8];
-    snprintf(timeBuf, sizeof(timeBuf), "%02lu:%02lu", mins % 100, secs);
+// Scroll start that puts line diagLogHead (the oldest entry) at the top of
+// the area; rotation 2 moves the other way, as slideScrollLine() does
+static uint16_t diagScrollLine() {
+  int lines = diagLogRows * kDiagLineHeight;
+  int head = diagLogHead * kDiagLineHeight;
+  return (uint16_t)(diagScrollTop() + ((tft.getRotation() == 2) ? (lines - head) % lines : head));
+}
+#endif
 
-    // Truncate message to fit screen (wider with small font)
-    String msg = String(logBuffer[idx].message);
-    if (msg.length() > 32) {
-      msg = msg.substring(0, 29) + "...";
+// Log entries added since the last draw, appended below the shown ones
+static void appendDiagnosticsLogs() {
+  uint32_t fresh = logTotal - diagLogSeen;
+  int count = (int)min(fresh, (uint32_t)min(logCount, diagLogRows));
+  diagLogSeen = logTotal;
+  if (count == 0) return;
+  diagLogLines += count;
+
+  int newest = 0;
+  for (int back = count; back > 0; back--) {
+    if (diagLogShown < diagLogRows) {
+      newest = diagLogShown++;
+      drawLogLine(newest, recentLog(back));
+      continue;
+    }
+    // Full: overwrite the oldest line (a scroll area then moves it round to
+    // the bottom; a ring leaves it where it is)
+    newest = diagLogHead;
+    drawLogLine(newest, recentLog(back));
+    diagLogHead = (diagLogHead + 1) % diagLogRows;
+#if PANEL_SCROLL_SUPPORTED
+    if (diagLogScroll) {
+      setScrollStart(diagScrollLine());
+      diagLogScrolls++;
     }
+#endif
+  }
+  markNewestLog(newest);
+}
 
-    String logLine = String(timeBuf) + " " + msg;
-    tft.drawString(logLine, 10, y);
-    y += lineHeight;
+// Draw the current page's lines; only lines that changed reach the panel
+static void renderDiagnosticsPage() {
+  tft.setTextFont(1);  // 6x8 pixel bitmap font
+  tft.setTextSize(1);  // Normal size (not scaled)
+  tft.setTextDatum(TL_DATUM);
+  diagLineSlot = 0;
+
+  int y = 6;
+  char title[kDiagLineChars];
+  snprintf(title, sizeof(title), "=== DIAGNOSTICS %d/%d ===", diagnosticsPage + 1, DIAGNOSTICS_PAGES);
+  diagPrint(y, TFT_CYAN, title);
+  y += kDiagLineHeight + 2;
+
+  if (diagnosticsPage == 1) {
+    drawTimingPage(y, kDiagLineHeight);
+  } else {
+    diagLogTop = drawSystemPage(y, kDiagLineHeight);
+  }
+}
+
+// The current page times out (DIAGNOSTICS_TIMEOUT) unless it is the live
+// system page held open by DIAGNOSTICS_CONSOLE_HOLD
+static bool diagnosticsTimesOut() {
+  return diagnosticsPage != 0 || !DIAGNOSTICS_CONSOLE_HOLD;
+}
+
+// Drop the log scroll area (before anything else is drawn full screen)
+static void endDiagnosticsScroll() {
+  if (!diagLogScroll) return;
+  resetPanelScroll();
+  diagLogScroll = false;
+}
+
+// Draw full-screen diagnostics overlay (page diagnosticsPage)
+void drawDiagnosticsScreen() {
+  abortStaticLayout();
+  endDiagnosticsScroll();
+  tft.fillScreen(TFT_BLACK);
+
+  // Force unload any smooth fonts and reset to bitmap font
+  tft.unloadFont();
+  tft.setTextWrap(false);
+
+  for (int i = 0; i < kDiagMaxLines; i++) {
+    diagLines[i].y = -1;
   }
+  diagWifiUp = WiFi.isConnected();
+  renderDiagnosticsPage();
 
   // Footer
   tft.setTextColor(TFT_DARKGREY, TFT_BLACK);
   tft.setTextDatum(BC_DATUM);
-  tft.drawString("Touch to dismiss (15s timeout)", tft.width() / 2, tft.height() - 2);
+  const char *footer;
+  if (diagnosticsPage + 1 < DIAGNOSTICS_PAGES) {
+    footer = diagnosticsTimesOut() ? "Touch: next page (15s timeout)" : "Touch: next page";
+  } else {
+    footer = "Touch to dismiss (15s timeout)";
+  }
+  tft.drawString(footer, tft.width() / 2, tft.height() - 2);
+  tft.setTextDatum(TL_DATUM);
+
+  if (diagnosticsPage == 0) {
+    // Remaining height above the footer, in whole lines
+    diagLogRows = min((tft.height() - diagLogTop - 12) / kDiagLineHeight, LOG_BUFFER_SIZE);
+    if (diagLogRows < 0) diagLogRows = 0;
+#if PANEL_SCROLL_SUPPORTED
+    if (diagLogRows > 0 && tft.height() == TFT_HEIGHT) {
+      setScrollArea(diagScrollTop(), diagLogRows * kDiagLineHeight);
+      diagLogHead = 0;
+      setScrollStart(diagScrollLine());
+      diagLogScroll = true;
+    }
+#endif
+    drawLogArea();
+  }
+}
+
+// Return to clock display
+void closeDiagnosticsScreen() {
+  showingDiagnostics = false;
+  endDiagnosticsScroll();
+  // Properly unload any loaded font before resetting tracking
+  if (currentSmoothFont != nullptr) {
+    tft.unloadFont();
+  }
+  currentSmoothFont = nullptr;  // Reset font tracking so smooth fonts reload
+  drawStaticLayout();
+}
+
+// Live update while open: changed lines, new log entries
+void refreshDiagnosticsScreen() {
+  if (WiFi.isConnected() != diagWifiUp) {
+    drawDiagnosticsScreen();  // Network block changed height: lay out again
+    return;
+  }
+  diagRefreshes++;
+  renderDiagnosticsPage();
+  if (diagnosticsPage == 0) {
+    appendDiagnosticsLogs();
+  }
 }
 
 // =========================
@@ -2625,57 +4135,25 @@ void handleTouch() {
 
   DBG_INFO("Touch detected!\n");
 
-  // Toggle diagnostics screen
-  showingDiagnostics = !showingDiagnostics;
-
-  if (showingDiagnostics) {
+  // Open diagnostics, step through its pages, then close
+  if (!showingDiagnostics || diagnosticsPage + 1 < DIAGNOSTICS_PAGES) {
+    diagnosticsPage = showingDiagnostics ? diagnosticsPage + 1 : 0;
+    showingDiagnostics = true;
     diagnosticsStartTime = now;
     drawDiagnosticsScreen();
-    DBG_INFO("Diagnostics screen opened\n");
+    DBG_INFO("Diagnostics page %d opened\n", diagnosticsPage + 1);
   } else {
-    // Return to clock display
-    // Properly unload any loaded font before resetting tracking
-    if (currentSmoothFont != nullptr) {
-      tft.unloadFont();
-    }
-    currentSmoothFont = nullptr;  // Reset font tracking so smooth fonts reload
-    drawStaticLayout();
-    lastDate[0] = '\0';  // Force redraw
-    for (int i = 0; i < 6; i++) {
-      lastTimes[i][0] = '\0';
-      lastPrevDay[i] = false;
-      lastColonState[i] = false;
-    }
-    // Reset analog clock state
-    lastSecond = -1;
-    lastMinute = -1;
-    lastHour = -1;
+    closeDiagnosticsScreen();
     DBG_INFO("Diagnostics screen closed\n");
   }
 }
 
 // Check if diagnostics should auto-dismiss
 void checkDiagnosticsTimeout() {
-  if (!showingDiagnostics) return;
+  if (!showingDiagnostics || !diagnosticsTimesOut()) return;
 
   if (millis() - diagnosticsStartTime > DIAGNOSTICS_TIMEOUT) {
-    showingDiagnostics = false;
-    // Properly unload any loaded font before resetting tracking
-    if (currentSmoothFont != nullptr) {
-      tft.unloadFont();
-    }
-    currentSmoothFont = nullptr;  // Reset font tracking so smooth fonts reload
-    drawStaticLayout();
-    lastDate[0] = '\0';  // Force redraw
-    for (int i = 0; i < 6; i++) {
-      lastTimes[i][0] = '\0';
-      lastPrevDay[i] = false;
-      lastColonState[i] = false;
-    }
-    // Reset analog clock state
-    lastSecond = -1;
-    lastMinute = -1;
-    lastHour = -1;
+    closeDiagnosticsScreen();
     DBG_INFO("Diagnostics auto-closed\n");
   }
 }
@@ -2763,14 +4241,21 @@ void setup() {
   touchscreen.begin(touchSPI);
   touchscreen.setRotation(0);  // Portrait mode to match display
 
+  // loop() blocks until the next display event; touch IRQ wakes it early
+  loopTaskHandle = xTaskGetCurrentTaskHandle();
+  attachInterrupt(digitalPinToInterrupt(XPT2046_IRQ), onTouchIrq, CHANGE);
+
   DBG_INFO("CYD World Clock v%s starting...\n", FIRMWARE_VERSION);
 
   // Mount filesystem SILENTLY (serial output only, no screen yet)
   DBG_INFO("Mounting LittleFS...\n");
-  smoothFontsReady = LittleFS.begin(false);
-  if (smoothFontsReady) {
+  littleFsReady = LittleFS.begin(false);
+  if (littleFsReady) {
     DBG_OK("LittleFS mounted");
     logLittleFSContents();
+    if (tzdbOpen(TZDB_PATH)) {
+      DBG_INFO("tzdb: %u zones in %s\n", tzdbZoneCount(), TZDB_PATH);
+    }
   } else {
     DBG_ERROR("LittleFS mount failed\n");
   }
@@ -2789,10 +4274,14 @@ void setup() {
   // NOW initialize startup display and show boot messages
   // All messages will be in correct orientation
   initStartupDisplay();
+#if DISPLAY_DMA_ENABLED
+  dmaReady = tft.initDMA();
+  DBG_INFO("Display DMA %s\n", dmaReady ? "enabled" : "unavailable, bands sent blocking");
+#endif
 
   // Show filesystem status
   showStartupStep("Init LittleFS...");
-  if (smoothFontsReady) {
+  if (littleFsReady) {
     showStartupStep("LittleFS OK", TFT_GREEN);
   } else {
     showStartupStep("LittleFS FAIL", TFT_RED);
@@ -2854,25 +4343,11 @@ void setup() {
   // Splash screen (rotation already applied after config load)
   showSplashScreen();
 
-  // Draw clock interface
+  // Draw clock interface (widgets draw the times once it's painted)
   drawStaticLayout();
 
-  // Reset cached state to force full redraw of times
-  lastDate[0] = '\0';
-  for (int i = 0; i < 6; i++) {
-    lastTimes[i][0] = '\0';
-    lastPrevDay[i] = false;
-    lastNextDay[i] = false;
-    // Use value 2 (invalid for bool comparison) to force first draw
-    // Actually just use true - the empty lastTimes will force timeChanged=true
-    lastColonState[i] = true;
-  }
-  // Reset analog clock state
-  lastSecond = -1;
-  lastMinute = -1;
-  lastHour = -1;
   // Force time cache refresh
-  lastBatchUpdate = 0;
+  updateAllCityTimes();
 
   // Show ready message
   DBG_INFO("==============================================\n");
@@ -2880,9 +4355,33 @@ void setup() {
   DBG_INFO("==============================================\n");
 }
 
-// Track last display update time
-static unsigned long lastDisplayUpdate = 0;
-const unsigned long DISPLAY_UPDATE_INTERVAL = 1000;  // Update display every 1 second
+// =========================
+// Next-Event Scheduler
+// =========================
+// Everything visible changes on a wall-clock second boundary (colon blink,
+// second hand) or a minute boundary (HH:MM, prev/next day, DST - offsets are
+// whole minutes), plus millis()-based cadences (sensor, debug, diagnostics
+// timeout). loop() computes the nearest of these and blocks on a FreeRTOS
+// task notification until then; the touch IRQ wakes it early.
+//
+// The web server and OTA are polled, one step per handleClient() call, so
+// while a client is connected, for NET_ACTIVE_WINDOW_MS after one was seen
+// (the rest of a page load, typeahead queries) and during an OTA update the
+// block is capped at NET_POLL_MS. Only an idle device sleeps to the next
+// display event; the first request after idle waits for that wake.
+const uint32_t NET_POLL_MS = 20;
+const unsigned long NET_ACTIVE_WINDOW_MS = 3000;
+
+// A web client is connected (request being read, answered or closed)
+static void noteNetActivity() {
+  if (!server.client()) return;
+  lastNetActivity = millis();
+  netActivitySeen = true;
+}
+
+static bool networkActive(unsigned long nowMs) {
+  return otaActive || (netActivitySeen && nowMs - lastNetActivity < NET_ACTIVE_WINDOW_MS);
+}
 
 // Track last debug output time - 5 minutes to reduce overhead
 static unsigned long lastDebugOutput = 0;
@@ -2890,77 +4389,123 @@ const unsigned long DEBUG_OUTPUT_INTERVAL = 300000;  // Output debug log every 5
 
 // Track last sensor reading time
 static unsigned long lastSensorRead = 0;
-const unsigned long SENSOR_READ_INTERVAL = 10000;  // Read sensor every 10 seconds
 
-void loop() {
-  ArduinoOTA.handle();
-  server.handleClient();  // Handle WebServer requests
+static time_t lastDisplaySecond = 0;          // Wall-clock second last drawn
 
-  // Handle touch input (always, for responsiveness)
-  handleTouch();
-  checkDiagnosticsTimeout();
+#if CLOCK_FRAMES_ENABLED
+// Clock on the current screen (nullptr on the standard portrait screen)
+static AnalogClock *activeClock() {
+  if (config.landscapeMode) return &landscapeClock;
+  if (sensorAvailable && config.enableScreenRotation && showingAlternateScreen) return &alternateClock;
+  return nullptr;
+}
 
-  // Skip clock updates when showing diagnostics
-  if (showingDiagnostics) {
-    delay(50);  // Fast polling for touch response
-    return;
-  }
+static uint32_t lastClockSlot = 0;  // Frame slot (kClockFrameUs of wall time) last drawn
+
+// Frames between second ticks, on wall-clock frame boundaries
+static void serviceClockFrame() {
+  AnalogClock *clock = activeClock();
+  if (clock == nullptr) return;
+  WallTime now = wallNow();
+  uint32_t slot = (uint32_t)now.sec * (1000000 / kClockFrameUs) + now.us / kClockFrameUs;
+  if (slot == lastClockSlot) return;
+  lastClockSlot = slot;
+  updateClockNow(*clock);
+}
+#endif
 
-  // Only update display once per second
-  unsigned long now = millis();
-  if (now - lastDisplayUpdate < DISPLAY_UPDATE_INTERVAL) {
-    delay(50);  // Short delay for touch responsiveness
-    return;
+// Touch IRQ (CHANGE): wake loop() so touch stays responsive while blocked
+void IRAM_ATTR onTouchIrq() {
+  BaseType_t higherPriorityWoken = pdFALSE;
+  if (loopTaskHandle != nullptr) {
+    vTaskNotifyGiveFromISR(loopTaskHandle, &higherPriorityWoken);
   }
-  lastDisplayUpdate = now;
+  if (higherPriorityWoken) {
+    portYIELD_FROM_ISR();
+  }
+}
 
-  // Handle screen rotation in portrait mode with environmental sensor
-  if (!config.landscapeMode && sensorAvailable && config.enableScreenRotation) {
-    unsigned long flipInterval = config.screenFlipInterval * 1000UL; // Convert to milliseconds
+// Milliseconds remaining until a millis()-based cadence is due (0 = due now)
+static uint32_t msUntilDue(unsigned long nowMs, unsigned long last, unsigned long interval) {
+  unsigned long elapsed = nowMs - last;
+  return (elapsed >= interval) ? 0 : (uint32_t)(interval - elapsed);
+}
 
-    if (now - lastScreenFlip >= flipInterval) {
-      showingAlternateScreen = !showingAlternateScreen;
-      lastScreenFlip = now;
+// Milliseconds until the next instant anything on screen (or a periodic
+// task) needs attention
+static uint32_t msUntilNextEvent() {
+  unsigned long nowMs = millis();
+  uint32_t wait;
 
-      DBG_VERBOSE("Flipping to %s screen\n", showingAlternateScreen ? "alternate" : "standard");
+  if (showingDiagnostics) {
+    // Diagnostics refresh once a second, and its timeout
+    WallTime wall = wallNow();
+    wait = (1000000 - wall.us + 999) / 1000;
+    if (diagnosticsTimesOut()) {
+      uint32_t timeoutWait = msUntilDue(nowMs, diagnosticsStartTime, DIAGNOSTICS_TIMEOUT + 1);
+      if (timeoutWait < wait) wait = timeoutWait;
+    }
+  } else {
+    // Next wall-clock second boundary (colon blink / second hand / minute),
+    // rounded up so the wake lands after it, not just before
+    WallTime wall = wallNow();
+    wait = (1000000 - wall.us + 999) / 1000;
 
-      if (showingAlternateScreen) {
-        drawAlternatePortraitStatic();
-        // Force full redraw on next update
-        lastSecond = -1;
-        lastMinute = -1;
-        lastHour = -1;
-      } else {
-        // Clear screen before switching back to standard portrait
-        tft.fillScreen(COLOR_BG);
-        drawStaticLayoutPortrait();
-        // Force full redraw
-        lastDate[0] = '\0';
-        for (int i = 0; i < 6; i++) {
-          lastTimes[i][0] = '\0';
-          lastPrevDay[i] = false;
-          lastNextDay[i] = false;
-          lastColonState[i] = false;
-        }
-      }
+    if (sensorAvailable) {
+      uint32_t sensorWait = msUntilDue(nowMs, lastSensorRead, SENSOR_UPDATE_INTERVAL);
+      if (sensorWait < wait) wait = sensorWait;
+    }
+    if (debugLevel >= DBG_LEVEL_INFO) {
+      uint32_t debugWait = msUntilDue(nowMs, lastDebugOutput, DEBUG_OUTPUT_INTERVAL);
+      if (debugWait < wait) wait = debugWait;
+    }
+    if (staticLayoutPending()) {
+      uint32_t bandWait = msUntilStaticBand();
+      if (bandWait < wait) wait = bandWait;
+    }
+#if CLOCK_FRAMES_ENABLED
+    if (activeClock() != nullptr && !staticLayoutPending()) {
+      uint32_t frameWait = (kClockFrameUs - wall.us % kClockFrameUs + 999) / 1000;
+      if (frameWait < wait) wait = frameWait;
     }
+#endif
   }
+  if (networkActive(nowMs) && wait > NET_POLL_MS) wait = NET_POLL_MS;
+  return wait;
+}
 
-  // Update clock display
-  if (!config.landscapeMode && sensorAvailable && config.enableScreenRotation && showingAlternateScreen) {
-    // Use alternate portrait screen
-    drawAlternatePortraitUpdate();
-  } else {
-    // Use standard portrait or landscape screen
-    char dateStr[16];
-    formatDate(dateStr, sizeof(dateStr));
-    if (strcmp(dateStr, lastDate) != 0) {
-      drawHeaderDate(dateStr);
-      strlcpy(lastDate, dateStr, sizeof(lastDate));
-    }
-    drawTimes();
+// Loop pass finished: add its busy time to this second's total, and track
+// the longest pass while a static redraw is running
+static void endLoopPass() {
+  uint32_t busy = micros() - loopPassStart;
+  loopWindowUs += busy;
+  if (!staticMeasuring) return;
+  if (busy > staticLoopMaxUs) staticLoopMaxUs = busy;
+  if (!staticLayoutPending()) staticMeasuring = false;
+}
+
+// New wall-clock second: publish the last second's frame rate and CPU time
+static void rollSecondStats() {
+  clockFps = clockWindowFrames;
+  clockCpuUs = clockWindowUs;
+  loopCpuUs = loopWindowUs;
+  clockWindowFrames = 0;
+  clockWindowUs = 0;
+  loopWindowUs = 0;
+}
+
+// Block until the next event or a touch IRQ, whichever comes first
+static void waitForNextEvent() {
+  endLoopPass();
+  uint32_t waitMs = msUntilNextEvent();
+  if (waitMs > 0) {
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(waitMs) + 1);
   }
+}
 
+// Periodic (non-display) work with its own millis() cadence.
+// Runs on every wake so a due task never waits for the next second tick.
+static void runPeriodicTasks(unsigned long now) {
   // Display current times for all cities - compact format
   // Only output every 5 minutes to reduce overhead
   // Uses Serial.print directly to avoid heap allocation from String concatenation
@@ -2968,8 +4513,10 @@ void loop() {
   if (debugLevel >= DBG_LEVEL_INFO && (now - lastDebugOutput >= DEBUG_OUTPUT_INTERVAL)) {
     lastDebugOutput = now;
 
-    // Ensure cache is up to date (uses batch update if minute changed)
-    formatTime(0);
+    // Cache is refreshed on every minute boundary by loop()
+    if (!timeCacheInitialized) {
+      updateAllCityTimes();
+    }
 
     // Build compact single-line output using Serial.print to avoid String heap allocation
     Serial.print("[INFO] ");
@@ -2977,15 +4524,15 @@ void loop() {
     // Home city (with HOME indicator) - use cached values directly
     Serial.print(config.homeCityLabel);
     Serial.print(" (HOME) ");
-    Serial.print(timeCache[0].timeStr);
+    Serial.print(timeCache.timeStr[0]);
 
     // Remote cities - use cached values directly
-    for (int i = 0; i < 5; i++) {
+    for (int i = 0; i < config.remoteCount; i++) {
       Serial.print(" | ");
       Serial.print(config.remoteCities[i]);
       Serial.print(" ");
-      Serial.print(timeCache[i + 1].timeStr);
-      if (timeCache[i + 1].prevDay) {
+      Serial.print(timeCache.timeStr[i + 1]);
+      if (timeCache.prevDay[i + 1]) {
         Serial.print(" (PREV DAY)");
       }
     }
@@ -3035,6 +4582,105 @@ void loop() {
   }
 }
 
+void loop() {
+  loopPassStart = micros();
+  loopWakeups++;
+  ArduinoOTA.handle();
+  server.handleClient();  // Handle WebServer requests
+  noteNetActivity();
+
+  // Handle touch input (always, for responsiveness)
+  handleTouch();
+  checkDiagnosticsTimeout();
+
+  // Skip clock updates when showing diagnostics (kept live instead)
+  if (showingDiagnostics) {
+    refreshDiagnosticsScreen();
+    waitForNextEvent();
+    return;
+  }
+
+  // Static layout being painted: one band per pass, no clock updates
+  if (staticLayoutPending()) {
+    if (msUntilStaticBand() > 0) {
+      waitForNextEvent();  // Slide: next frame not due yet
+      return;
+    }
+    if (serviceStaticLayout()) {
+      endLoopPass();
+      return;
+    }
+    lastDisplaySecond = 0;  // Layout done: draw the clock on this pass
+  }
+
+  unsigned long now = millis();
+  runPeriodicTasks(now);
+
+  // Only update display when the wall-clock second changes
+  WallTime wall = wallNow();
+  time_t nowSec = wall.sec;
+  if (nowSec == lastDisplaySecond) {
+#if CLOCK_FRAMES_ENABLED
+    serviceClockFrame();
+#endif
+    waitForNextEvent();
+    return;
+  }
+  lastDisplaySecond = nowSec;
+  tickLateUs = wall.us;
+  if (tickLateUs > tickLateMaxUs) tickLateMaxUs = tickLateUs;
+  rollSecondStats();
+
+  // Minute boundary: one batched conversion for every city
+  bool minuteChanged = (nowSec / 60) != (lastBatchUpdate / 60);
+  if (minuteChanged) {
+    updateAllCityTimes();
+  }
+
+  // Handle screen rotation in portrait mode with environmental sensor
+  if (!config.landscapeMode && sensorAvailable && config.enableScreenRotation) {
+    unsigned long flipInterval = config.screenFlipInterval * 1000UL; // Convert to milliseconds
+
+    if (now - lastScreenFlip >= flipInterval) {
+      showingAlternateScreen = !showingAlternateScreen;
+      lastScreenFlip = now;
+
+      DBG_VERBOSE("Flipping to %s screen\n", showingAlternateScreen ? "alternate" : "standard");
+
+      // Slide the other layout in (widgets redraw on top once it's done)
+      slideStaticLayout(showingAlternateScreen ? LAYER_ALTERNATE : LAYER_MAIN);
+    }
+  }
+
+  // A layout was just submitted: the clock is drawn once it's painted
+  if (staticLayoutPending()) {
+    endLoopPass();
+    return;
+  }
+
+  // Page through remote cities when they don't fit on one screen
+  if (remotePageCount() > 1 && nowSec - lastPageFlip >= REMOTE_PAGE_INTERVAL_SEC) {
+    lastPageFlip = nowSec;
+    flipRemotePage();
+  }
+
+  // Date text can only change on a minute boundary
+  if (minuteChanged || dateText[0] == '\0') {
+    formatDate(dateText, sizeof(dateText));
+  }
+
+  // Update clock display
+  if (!config.landscapeMode && sensorAvailable && config.enableScreenRotation && showingAlternateScreen) {
+    // Use alternate portrait screen
+    drawAlternatePortraitUpdate();
+  } else {
+    // Use standard portrait or landscape screen
+    drawTimes();
+  }
+
+  waitForNextEvent();
+}
+
 // =========================
 // Screenshot Functionality
 // =========================
@@ -3051,6 +4697,7 @@ void loop() {
  */
 void takeScreenshot() {
   DBG_INFO("Taking screenshot...\n");
+  finishStaticLayout();
 
   // PPM header: P6 = binary RGB, width height, max color value
   Serial.println("P6");
@@ -3089,6 +4736,7 @@ void takeScreenshot() {
  */
 void takeScreenshotRaw() {
   DBG_INFO("Taking raw screenshot (RGB565)...\n");
+  finishStaticLayout();
   Serial.println("SCREENSHOT_START");
   Serial.printf("WIDTH:%d\n", tft.width());
   Serial.printf("HEIGHT:%d\n", tft.height());
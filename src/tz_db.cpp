@@ -0,0 +1,197 @@
+// Zoneinfo transition database reader (see tz_db.h).
+// Pure C/C++ stdio - on ESP32 LittleFS is mounted into the VFS at /littlefs,
+// and the native env reads the same file from the host filesystem.
+#include "tz_db.h"
+
+#include <limits>
+#include <stdio.h>
+#include <string.h>
+
+static const time_t kTimeMin = std::numeric_limits<time_t>::min();
+static const time_t kTimeMax = std::numeric_limits<time_t>::max();
+
+static char dbPath[48] = "";
+static uint16_t dbZoneCount = 0;
+static uint32_t dbIndexOffset = 0;
+static uint32_t dbReads = 0;
+
+static uint16_t readU16(const uint8_t* p) {
+  return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t readU32(const uint8_t* p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// Record times are u32 seconds since 1970; clamp where time_t is 32-bit
+static time_t toTime(uint32_t secs) {
+  return ((uint64_t)secs > (uint64_t)kTimeMax) ? kTimeMax : (time_t)secs;
+}
+
+static bool readAt(FILE* f, uint32_t offset, void* buf, size_t len) {
+  dbReads++;
+  return fseek(f, offset, SEEK_SET) == 0 && fread(buf, 1, len, f) == len;
+}
+
+bool tzdbOpen(const char* path) {
+  dbZoneCount = 0;
+  dbPath[0] = '\0';
+
+  FILE* f = fopen(path, "rb");
+  if (!f) return false;
+
+  uint8_t header[TZDB_HEADER_SIZE];
+  bool ok = readAt(f, 0, header, sizeof(header));
+  if (ok) {
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    ok = memcmp(header, TZDB_MAGIC, 4) == 0 && header[4] == TZDB_VERSION &&
+         header[5] == TZDB_RECORD_SIZE && (long)readU32(header + 12) == size;
+  }
+  fclose(f);
+  if (!ok) return false;
+
+  strncpy(dbPath, path, sizeof(dbPath) - 1);
+  dbPath[sizeof(dbPath) - 1] = '\0';
+  dbZoneCount = readU16(header + 6);
+  dbIndexOffset = readU32(header + 8);
+  return true;
+}
+
+bool tzdbAvailable() {
+  return dbZoneCount > 0;
+}
+
+uint16_t tzdbZoneCount() {
+  return dbZoneCount;
+}
+
+bool tzdbZoneName(uint16_t index, char* out, size_t len) {
+  if (index >= dbZoneCount || len == 0) return false;
+  FILE* f = fopen(dbPath, "rb");
+  if (!f) return false;
+
+  char name[TZDB_NAME_LEN];
+  bool ok = readAt(f, dbIndexOffset + (uint32_t)index * TZDB_INDEX_ENTRY_SIZE, name, sizeof(name));
+  fclose(f);
+  if (!ok) return false;
+
+  name[TZDB_NAME_LEN - 1] = '\0';
+  strncpy(out, name, len - 1);
+  out[len - 1] = '\0';
+  return true;
+}
+
+bool tzdbFindZone(const char* name, TzDbZone* zone) {
+  if (!tzdbAvailable()) return false;
+  FILE* f = fopen(dbPath, "rb");
+  if (!f) return false;
+
+  // Binary search the sorted fixed-width name index
+  uint8_t entry[TZDB_INDEX_ENTRY_SIZE];
+  int32_t lo = 0;
+  int32_t hi = (int32_t)dbZoneCount - 1;
+  bool found = false;
+  while (lo <= hi) {
+    int32_t mid = (lo + hi) / 2;
+    if (!readAt(f, dbIndexOffset + (uint32_t)mid * TZDB_INDEX_ENTRY_SIZE, entry, sizeof(entry))) break;
+    int cmp = strncmp(name, (const char*)entry, TZDB_NAME_LEN);
+    if (cmp == 0) {
+      found = true;
+      break;
+    }
+    if (cmp < 0) {
+      hi = mid - 1;
+    } else {
+      lo = mid + 1;
+    }
+  }
+
+  char footer[64] = "";
+  if (found) {
+    uint32_t footerOffset = readU32(entry + TZDB_NAME_LEN + 4);
+    // Footer may sit near the end of the file: a short read is fine
+    dbReads++;
+    if (fseek(f, footerOffset, SEEK_SET) == 0) {
+      size_t n = fread(footer, 1, sizeof(footer) - 1, f);
+      footer[n] = '\0';
+    }
+  }
+  fclose(f);
+  if (!found) return false;
+
+  *zone = TzDbZone{};
+  zone->transOffset = readU32(entry + TZDB_NAME_LEN);
+  zone->transCount = readU16(entry + TZDB_NAME_LEN + 8);
+  zone->initialOffsetMins = (int16_t)readU16(entry + TZDB_NAME_LEN + 10);
+  zone->hasFooter = footer[0] != '\0';
+  if (zone->hasFooter) {
+    parseTimezoneString(footer, &zone->footer);  // Best effort, like config strings
+  }
+  zone->segOffsetMins = zone->initialOffsetMins;  // Empty segment: first query searches
+  return true;
+}
+
+// Find the record segment containing utc and cache it in zone
+static bool loadSegment(time_t utc, TzDbZone* zone) {
+  FILE* f = fopen(dbPath, "rb");
+  if (!f) return false;
+
+  // First record with time > utc (records are sorted, all >= 1970)
+  uint8_t rec[TZDB_RECORD_SIZE * 2];
+  int32_t lo = 0;
+  int32_t hi = zone->transCount;
+  bool ok = true;
+  while (lo < hi && ok) {
+    int32_t mid = (lo + hi) / 2;
+    ok = readAt(f, zone->transOffset + (uint32_t)mid * TZDB_RECORD_SIZE, rec, 4);
+    if ((int64_t)readU32(rec) <= (int64_t)utc) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  int32_t idx = lo - 1;  // Record in force, -1 = before the first one
+  bool last = (idx == (int32_t)zone->transCount - 1);
+
+  if (ok && idx >= 0) {
+    ok = readAt(f, zone->transOffset + (uint32_t)idx * TZDB_RECORD_SIZE, rec, last ? TZDB_RECORD_SIZE : sizeof(rec));
+  } else if (ok && !last) {
+    ok = readAt(f, zone->transOffset, rec + TZDB_RECORD_SIZE, 4);  // Segment ends at record 0
+  }
+  fclose(f);
+  if (!ok) return false;
+
+  if (idx >= 0) {
+    zone->segStartUtc = toTime(readU32(rec));
+    zone->segOffsetMins = (int16_t)readU16(rec + 4);
+    zone->segIsDst = rec[6] != 0;
+  } else {
+    zone->segStartUtc = kTimeMin;
+    zone->segOffsetMins = zone->initialOffsetMins;
+    zone->segIsDst = false;
+  }
+  zone->segEndUtc = last ? kTimeMax : toTime(readU32(rec + TZDB_RECORD_SIZE));
+  zone->segUsesFooter = last && zone->hasFooter;
+  return true;
+}
+
+int16_t tzdbOffsetAt(time_t utc, TzDbZone* zone, bool* isDst) {
+  bool inSegment = zone->segStartUtc < zone->segEndUtc &&
+                   utc >= zone->segStartUtc && utc < zone->segEndUtc;
+  if (!inSegment) {
+    loadSegment(utc, zone);  // On read failure keep the previous offset
+  }
+
+  if (zone->segUsesFooter) {
+    bool dst = isDstActive(utc, &zone->footer);
+    if (isDst) *isDst = dst;
+    return dst ? zone->footer.dstOffsetMins : zone->footer.stdOffsetMins;
+  }
+  if (isDst) *isDst = zone->segIsDst;
+  return zone->segOffsetMins;
+}
+
+uint32_t tzdbFileReads() {
+  return dbReads;
+}
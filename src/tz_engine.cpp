@@ -0,0 +1,218 @@
+// Manual timezone calculation (replaces setenv() to fix memory leak).
+// Pure C/C++ - no Arduino headers, so the native env can build it too.
+#include "tz_engine.h"
+#include "tz_db.h"
+
+// Calculate day of week for a given date (0 = Sunday)
+// Using Zeller-like formula
+static int dayOfWeek(int year, int month, int day) {
+  if (month < 3) {
+    month += 12;
+    year--;
+  }
+  int k = year % 100;
+  int j = year / 100;
+  int dow = (day + (13 * (month + 1)) / 5 + k + k / 4 + j / 4 - 2 * j) % 7;
+  // Adjust to 0=Sunday
+  dow = (dow + 6) % 7;
+  return dow;
+}
+
+static bool isLeapYear(int year) {
+  return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+// Get day of month for DST transition
+// rule: M.w.d where w=1-4 means "nth occurrence", w=5 means "last"
+static int getDstTransitionDay(int year, const DstRule* rule) {
+  int month = rule->month;
+  int targetDow = rule->dow;
+  int week = rule->week;
+
+  if (week == 5) {
+    // Last occurrence: start from end of month
+    int daysInMonth[] = {0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    // Leap year check
+    if (month == 2 && isLeapYear(year)) {
+      daysInMonth[2] = 29;
+    }
+    int lastDay = daysInMonth[month];
+    int lastDow = dayOfWeek(year, month, lastDay);
+    int diff = lastDow - targetDow;
+    if (diff < 0) diff += 7;
+    return lastDay - diff;
+  } else {
+    // Nth occurrence: find first occurrence then add weeks
+    int firstDow = dayOfWeek(year, month, 1);
+    int diff = targetDow - firstDow;
+    if (diff < 0) diff += 7;
+    int firstOccurrence = 1 + diff;
+    return firstOccurrence + (week - 1) * 7;
+  }
+}
+
+// Days since epoch of the (local) date a DST rule fires on in the given year
+static int32_t getDstTransitionDays(int year, const DstRule* rule) {
+  switch (rule->type) {
+    case DST_RULE_JULIAN_NO_LEAP:
+      // J1..J365: Feb 29 is skipped, so days from Mar 1 shift by one in leap years
+      return daysFromCivil(year, 1, 1) + rule->yday - 1 +
+             ((isLeapYear(year) && rule->yday >= 60) ? 1 : 0);
+    case DST_RULE_DAY_OF_YEAR:
+      return daysFromCivil(year, 1, 1) + rule->yday;
+    default:
+      return daysFromCivil(year, rule->month, getDstTransitionDay(year, rule));
+  }
+}
+
+// Days since 1970-01-01 for a proleptic Gregorian date (month 1-12).
+// Integer-only, valid for any year - avoids mktime() which depends on TZ.
+int32_t daysFromCivil(int year, int month, int day) {
+  year -= (month <= 2);
+  const int era = (year >= 0 ? year : year - 399) / 400;
+  const int yoe = year - era * 400;                                   // [0, 399]
+  const int doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;  // [0, 365]
+  const int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;              // [0, 146096]
+  return era * 146097 + doe - 719468;
+}
+
+// Days since 1970-01-01 -> proleptic Gregorian date (month 1-12).
+// Integer-only inverse of daysFromCivil().
+void civilFromDays(int32_t days, int* year, int* month, int* day) {
+  days += 719468;
+  const int32_t era = (days >= 0 ? days : days - 146096) / 146097;
+  const int doe = days - era * 146097;                                  // [0, 146096]
+  const int yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;  // [0, 399]
+  const int doy = doe - (365 * yoe + yoe / 4 - yoe / 100);              // [0, 365], Mar 1 = 0
+  const int mp = (5 * doy + 2) / 153;                                   // [0, 11], Mar = 0
+  *day = doy - (153 * mp + 2) / 5 + 1;
+  *month = mp < 10 ? mp + 3 : mp - 9;
+  *year = yoe + era * 400 + (*month <= 2);
+}
+
+// Split seconds since epoch (already shifted to local) into LocalTime fields
+static void fillLocalTime(time_t local, LocalTime* out) {
+  int32_t days = (int32_t)(local / 86400);
+  int32_t secs = (int32_t)(local % 86400);
+  if (secs < 0) {
+    secs += 86400;
+    days--;
+  }
+
+  int year = 0;
+  int month = 0;
+  int day = 0;
+  civilFromDays(days, &year, &month, &day);
+
+  out->year = year;
+  out->month = month;
+  out->day = day;
+  out->hour = secs / 3600;
+  out->minute = (secs / 60) % 60;
+  out->second = secs % 60;
+  int wday = (days + 4) % 7;  // 1970-01-01 was a Thursday
+  out->wday = (wday < 0) ? wday + 7 : wday;
+  out->yday = days - daysFromCivil(year, 1, 1);
+}
+
+// Rebuild the per-year DST transition cache for the year containing utc.
+// Called at most once per year per city (plus once after parsing).
+// POSIX: the start rule time is local standard time, the end rule time is
+// local daylight time, so each instant is converted with its own offset.
+static void rebuildDstCache(time_t utc, ParsedTimezone* tz) {
+  time_t approxLocal = utc + (tz->stdOffsetMins * 60);
+  int32_t days = (int32_t)(approxLocal / 86400);
+  if (approxLocal % 86400 < 0) days--;
+  int year = 0;
+  int month = 0;
+  int day = 0;
+  civilFromDays(days, &year, &month, &day);
+
+  const time_t stdShift = (time_t)tz->stdOffsetMins * 60;
+  const time_t dstShift = (time_t)tz->dstOffsetMins * 60;
+
+  tz->yearStartUtc = (time_t)daysFromCivil(year, 1, 1) * 86400 - stdShift;
+  tz->yearEndUtc = (time_t)daysFromCivil(year + 1, 1, 1) * 86400 - stdShift;
+
+  tz->dstStartUtc = (time_t)getDstTransitionDays(year, &tz->dstStart) * 86400 +
+                    tz->dstStart.hour * 3600 + tz->dstStart.minute * 60 - stdShift;
+  tz->dstEndUtc = (time_t)getDstTransitionDays(year, &tz->dstEnd) * 86400 +
+                  tz->dstEnd.hour * 3600 + tz->dstEnd.minute * 60 - dstShift;
+  tz->cacheYear = year;
+}
+
+// Check if DST is active for given UTC time
+// Hot path is two range compares against the cached instants; the cache is
+// only rebuilt when the year rolls over (or on first use after parsing).
+bool isDstActive(time_t utc, ParsedTimezone* tz) {
+  if (tz->db) {
+    bool dst = false;
+    tzdbOffsetAt(utc, tz->db, &dst);
+    return dst;
+  }
+  if (!tz->hasDst) return false;
+
+  if (tz->cacheYear == 0 || utc < tz->yearStartUtc || utc >= tz->yearEndUtc) {
+    rebuildDstCache(utc, tz);
+  }
+
+  if (tz->dstStartUtc < tz->dstEndUtc) {
+    // Northern hemisphere: DST active between start and end
+    return (utc >= tz->dstStartUtc && utc < tz->dstEndUtc);
+  }
+  // Southern hemisphere: DST spans the year boundary (e.g. Oct -> Apr)
+  return (utc >= tz->dstStartUtc || utc < tz->dstEndUtc);
+}
+
+// Convert one UTC instant for one timezone
+void utcToLocal(time_t utc, ParsedTimezone* tz, LocalTime* out) {
+  int16_t offsetMins;
+  if (tz->db) {
+    offsetMins = tzdbOffsetAt(utc, tz->db, nullptr);
+  } else {
+    offsetMins = isDstActive(utc, tz) ? tz->dstOffsetMins : tz->stdOffsetMins;
+  }
+  fillLocalTime(utc + (offsetMins * 60), out);
+  out->offsetMins = offsetMins;
+}
+
+// Convert one UTC instant for several cities in one pass (e.g. home + remotes)
+void utcToLocalBatch(time_t utc, ParsedTimezone* tzs, LocalTime* out, int count) {
+  for (int i = 0; i < count; i++) {
+    utcToLocal(utc, &tzs[i], &out[i]);
+  }
+}
+
+void localTimeToTm(const LocalTime* lt, struct tm* out) {
+  out->tm_year = lt->year - 1900;
+  out->tm_mon = lt->month - 1;
+  out->tm_mday = lt->day;
+  out->tm_hour = lt->hour;
+  out->tm_min = lt->minute;
+  out->tm_sec = lt->second;
+  out->tm_wday = lt->wday;
+  out->tm_yday = lt->yday;
+  out->tm_isdst = 0;
+}
+
+int compareLocalDate(const LocalTime* a, const LocalTime* b) {
+  if (a->year != b->year) return (a->year < b->year) ? -1 : 1;
+  if (a->yday != b->yday) return (a->yday < b->yday) ? -1 : 1;
+  return 0;
+}
+
+void formatTimeHHMM(const LocalTime* lt, char* out) {
+  out[0] = '0' + lt->hour / 10;
+  out[1] = '0' + lt->hour % 10;
+  out[2] = ':';
+  out[3] = '0' + lt->minute / 10;
+  out[4] = '0' + lt->minute % 10;
+  out[5] = '\0';
+}
+
+// Get local time from UTC without using setenv() - NO MEMORY LEAK
+void getLocalTimeNoSetenv(time_t utc, ParsedTimezone* tz, struct tm* out) {
+  LocalTime lt;
+  utcToLocal(utc, tz, &lt);
+  localTimeToTm(&lt, out);
+}
@@ -0,0 +1,404 @@
+#!/usr/bin/env python3
+"""vlw2h.py - compile data/*.vlw smooth fonts into include/fonts_vlw.h.
+
+The firmware loads its fonts with tft.loadFont(array) from these const arrays
+(linked into flash) instead of reading .vlw files from LittleFS, so a font
+switch does no filesystem I/O. Runs before every firmware build (extra_scripts
+in platformio.ini); the header is regenerated each time but only rewritten
+when its content changes, so a build with nothing new recompiles nothing.
+Fonts not compiled in still load from LittleFS.
+
+Only fonts whose name appears as a string literal in src/ or include/ are
+compiled in, and each is cut down to the glyphs the sources draw with it.
+TFT_eSPI parses and allocates metrics per glyph on every loadFont(), so load
+time and font RAM shrink with the glyph count. A font's glyphs are found by
+scanning the sources (see FontScan):
+
+- string literals drawn after setFont(font) in the same function, and the
+  sample passed to measureFont(font, fallback, sample)
+- the text of each widget source (the case blocks of widgetContent()) added
+  with addWidget(..., font, fallback); printf conversions such as %d add the
+  digits and '-'. Widgets given glyph cells (setGlyphCells()) draw the
+  TIME_GLYPHS cell characters, whatever their source copies in.
+
+Text that isn't a literal (a city label, a string built at run time) makes
+the font free text: it keeps every glyph, and each timezones[] city name
+must be drawable in it. A character the sources need that the .vlw lacks
+fails the build, naming the font and the characters.
+
+Usage:
+    python3 tools/fonts/vlw2h.py                 # data/*.vlw -> include/fonts_vlw.h
+"""
+
+import glob
+import os
+import re
+import struct
+import sys
+
+HEADER_NAME = os.path.join("include", "fonts_vlw.h")
+CATALOG_NAME = os.path.join("include", "timezones.h")
+SOURCE_PATTERNS = ("src/*.cpp", "src/*.h", "include/*.h")
+
+# Constant holding the glyph cell characters (digits, then the colon)
+TIME_GLYPHS = "kTimeGlyphs"
+
+# Calls whose first argument is drawn in the current panel font
+TEXT_CALLS = ("drawString", "drawCentreString", "drawRightString", "textWidth", "print", "println")
+
+VLW_HEADER = struct.Struct(">6i")   # count, version, size, 0, ascent, descent
+VLW_GLYPH = struct.Struct(">7i")    # unicode, height, width, xAdvance, dY, dX, 0
+
+
+def symbol(prefix, name):
+    return prefix + re.sub(r"[^0-9A-Za-z]", "_", name)
+
+
+def read_vlw(data):
+    count, version, size, zero, ascent, descent = VLW_HEADER.unpack_from(data, 0)
+    glyphs = []
+    p = VLW_HEADER.size
+    bitmap = p + count * VLW_GLYPH.size
+    for _ in range(count):
+        g = VLW_GLYPH.unpack_from(data, p)
+        p += VLW_GLYPH.size
+        length = g[1] * g[2]
+        glyphs.append((g, data[bitmap:bitmap + length]))
+        bitmap += length
+    return (count, version, size, zero, ascent, descent), glyphs, data[bitmap:]
+
+
+def subset_vlw(data, keep):
+    """Rewrite a .vlw with only the glyphs whose code point is in keep."""
+    header, glyphs, trailer = read_vlw(data)
+    _, version, size, zero, ascent, descent = header
+
+    # TFT_eSPI takes line height and baseline from the tallest glyphs it
+    # loads (starting from the header values). Store the full font's extremes
+    # in the header so the subset lays out exactly like the full font.
+    for (code, height, _w, _xa, dy, _dx, _p), _bits in glyphs:
+        if 0x20 < code < 0xA0:
+            ascent = max(ascent, dy)
+            descent = max(descent, height - dy)
+
+    kept = [g for g in glyphs if g[0][0] in keep]
+    out = bytearray(VLW_HEADER.pack(len(kept), version, size, zero, ascent, descent))
+    for g, _bits in kept:
+        out += VLW_GLYPH.pack(*g)
+    for _g, bits in kept:
+        out += bits
+    return bytes(out + trailer)
+
+
+def vlw_codes(data):
+    _, glyphs, _ = read_vlw(data)
+    return {g[0][0] for g in glyphs}
+
+
+TOKEN = re.compile(r'//[^\n]*|/\*.*?\*/|"(?:[^"\\\n]|\\.)*"|\'(?:[^\'\\\n]|\\.)*\'', re.S)
+LITERAL = re.compile(r'"((?:[^"\\\n]|\\.)*)"')
+CONVERSION = re.compile(r"%[-+ #0]*\d*(?:\.\d+)?(?:hh|h|ll|l|z)?([diuxXcs%])")
+
+
+def strip_comments(text):
+    """Comments blanked (line breaks kept), literals left as they are."""
+    return TOKEN.sub(lambda m: m.group(0) if m.group(0)[0] != "/" else " " + "\n" * m.group(0).count("\n"), text)
+
+
+def unescape(body):
+    return re.sub(r"\\(.)", lambda m: {"n": "\n", "t": "\t"}.get(m.group(1), m.group(1)), body)
+
+
+def literal_value(expr):
+    """Value of expr if it is only (adjacent) string literals, else None."""
+    expr = expr.strip()
+    if not expr or LITERAL.sub("", expr).strip():
+        return None
+    return "".join(unescape(b) for b in LITERAL.findall(expr))
+
+
+def split_args(text, start):
+    """Arguments of the call whose '(' is at start, and the index after ')'."""
+    args, depth, arg, i = [], 0, start + 1, start
+    while i < len(text):
+        m = TOKEN.match(text, i)
+        if m:
+            i = m.end()
+            continue
+        c = text[i]
+        if c in "([{":
+            depth += 1
+        elif c in ")]}":
+            if depth == 1:
+                args.append(text[arg:i].strip())
+                return args, i + 1
+            depth -= 1
+        elif c == "," and depth == 1:
+            args.append(text[arg:i].strip())
+            arg = i + 1
+        i += 1
+    return args, len(text)
+
+
+class FontScan:
+    """What the sources draw with each font: chars, or free text."""
+
+    def __init__(self, project_dir, names):
+        self.names = set(names)
+        self.files = []
+        for pattern in SOURCE_PATTERNS:
+            for path in sorted(glob.glob(os.path.join(project_dir, pattern))):
+                if os.path.basename(path) == os.path.basename(HEADER_NAME):
+                    continue
+                with open(path, encoding="utf-8", errors="replace") as f:
+                    self.files.append((os.path.relpath(path, project_dir), strip_comments(f.read())))
+        self.text = "\n".join(text for _path, text in self.files)
+        self.used = sorted(n for n in names if '"%s"' % n in self.text)
+        self.chars = {n: set() for n in self.used}
+        self.free = {n: [] for n in self.used}  # Why the font is free text
+
+        # const char *kFontX = "Name"; constexpr char kX[] = "text";
+        self.aliases = {m.group(1): m.group(2) for m in re.finditer(
+            r'\b(\w+)\s*=\s*"([^"]+)"\s*;', self.text) if m.group(2) in self.names}
+        self.consts = {}
+        for m in re.finditer(r'\bchar\s+(\w+)\s*\[\]\s*=\s*((?:"(?:[^"\\\n]|\\.)*"\s*)+);', self.text):
+            self.consts[m.group(1)] = literal_value(m.group(2))
+        # const uint8_t list[] = {SRC_A, SRC_B};
+        self.lists = {m.group(1): re.findall(r"\w+", m.group(2)) for m in re.finditer(
+            r"\b(\w+)\s*\[\]\s*=\s*\{([\w\s,]*)\}", self.text)}
+        self.sources = self.widget_sources()
+        self.catalog = self.catalog_names(project_dir)
+
+        self.widgets = []
+        for path, text in self.files:
+            self.scan_calls(path, text)
+        for font, sources, cells, where in self.widgets:
+            for source in sources:
+                self.source_text(font, source, cells, where)
+
+    def font(self, expr):
+        expr = expr.strip()
+        value = literal_value(expr)
+        if value in self.names:
+            return value
+        return self.aliases.get(expr)
+
+    def value(self, expr):
+        value = literal_value(expr)
+        return value if value is not None else self.consts.get(expr.strip())
+
+    def add(self, font, expr, where):
+        value = self.value(expr)
+        if value is None:
+            self.free[font].append("%s (%s)" % (expr, where))
+        else:
+            self.chars[font].update(value)
+
+    def add_format(self, font, fmt, args, where, local):
+        """printf-style text: conversions stand for what they can print."""
+        args = list(args)
+        chars = CONVERSION.sub("", fmt) + "%" * fmt.count("%%")
+        self.chars[font].update(chars)
+        for conv in CONVERSION.findall(fmt):
+            if conv == "%":
+                continue
+            arg = args.pop(0) if args else ""
+            if conv in "diu":
+                self.chars[font].update("0123456789-")
+            elif conv in "xX":
+                self.chars[font].update("0123456789abcdefABCDEF")
+            else:
+                for value in local.get(arg.strip(), [None]):
+                    if value is None:
+                        self.add(font, arg, where)
+                    else:
+                        self.chars[font].update(value)
+
+    def widget_sources(self):
+        """case SRC_X: blocks of the widget text switch, by source."""
+        m = re.search(r"switch\s*\(\s*wd\.source\s*\)\s*\{", self.text)
+        if not m:
+            return {}
+        _, end = split_args(self.text, m.end() - 1)  # To the matching '}'
+        body = self.text[m.end():end]
+        blocks = {}
+        cases = list(re.finditer(r"\bcase\s+(\w+)\s*:", body))
+        for i, c in enumerate(cases):
+            stop = cases[i + 1].start() if i + 1 < len(cases) else len(body)
+            blocks[c.group(1)] = body[c.end():stop]
+        return blocks
+
+    def source_text(self, font, source, cells, where):
+        block = self.sources.get(source)
+        if block is None:
+            self.free[font].append("%s (%s, no case in widgetContent())" % (source, where))
+            return
+        # Locals set from literals, one value per alternative:
+        # const char *unit = f ? "o""F" : "o""C";
+        local = {}
+        for m in re.finditer(r"\b(\w+)\s*=\s*([^;]+);", block):
+            values = [literal_value(v) for v in re.findall(r'(?:"(?:[^"\\\n]|\\.)*"\s*)+', m.group(2))]
+            if values:
+                local[m.group(1)] = values
+        for m in re.finditer(r"\b(strlcpy|snprintf)\s*\(", block):
+            args, _ = split_args(block, m.end() - 1)
+            if not args or args[0] != "out":
+                continue
+            if m.group(1) == "snprintf":
+                fmt = literal_value(args[2]) if len(args) > 2 else None
+                if fmt is None:
+                    self.free[font].append("%s (%s)" % (source, where))
+                else:
+                    self.add_format(font, fmt, args[3:], "%s, %s" % (source, where), local)
+                continue
+            values = LITERAL.findall(args[1])
+            if values:
+                self.chars[font].update("".join(unescape(v) for v in values))
+            elif cells:
+                self.chars[font].update(self.consts.get(TIME_GLYPHS) or "")
+            else:
+                self.free[font].append("%s (%s)" % (args[1], source))
+
+    def scan_calls(self, path, text):
+        """Fonts selected and text drawn, in source order; widgets to self.widgets."""
+        calls = re.compile(r"\b(?:(\w+)\s*=\s*)?(?:[\w.>-]+(?:\.|->))?(\w+)\s*\(|[{}]")
+        current = None  # Panel font after the last setFont() in this function
+        depth = 0
+        assigned = {}   # Variable -> index in self.widgets of the addWidget() it holds
+        i = 0
+        while i <= len(text):
+            m = TOKEN.search(text, i)
+            chunk_end = m.start() if m else len(text)
+            for c in calls.finditer(text, i, chunk_end):
+                if c.group(0) in "{}":
+                    depth += 1 if c.group(0) == "{" else -1
+                    if depth == 0:
+                        current = None  # End of a function
+                    continue
+                name = c.group(2)
+                args, _ = split_args(text, c.end() - 1)
+                where = "%s:%d" % (path, text.count("\n", 0, c.start()) + 1)
+                if name == "setFont" and args:
+                    current = self.font(args[0])
+                elif name == "setFontOn" and len(args) > 2:
+                    current = self.font(args[2])
+                elif name == "measureFont" and len(args) > 2:
+                    current = self.font(args[0])
+                    if current:
+                        self.add(current, args[2], where)
+                elif name in TEXT_CALLS and args and current:
+                    self.add(current, args[0], where)
+                elif name == "addWidget" and args:
+                    fonts = [self.font(a) for a in args if self.font(a)]
+                    if fonts:
+                        # A source, or an element of a {SRC_A, SRC_B} list
+                        element = re.match(r"(\w+)\s*\[", args[0])
+                        sources = self.lists.get(element.group(1), []) if element else [args[0]]
+                        self.widgets.append([fonts[0], sources, False, where])
+                        if c.group(1):
+                            assigned[c.group(1)] = len(self.widgets) - 1
+                elif name == "setGlyphCells" and args and args[0] in assigned:
+                    self.widgets[assigned[args[0]]][2] = True
+            if not m:
+                break
+            i = m.end()
+
+    def catalog_names(self, project_dir):
+        path = os.path.join(project_dir, CATALOG_NAME)
+        if not os.path.exists(path):
+            return []
+        with open(path, encoding="utf-8", errors="replace") as f:
+            text = strip_comments(f.read())
+        return [unescape(n) for n in re.findall(r'\{\s*"((?:[^"\\\n]|\\.)*)"\s*,\s*"', text)]
+
+    def needs(self, font):
+        """Code points the sources draw with font, and whether it is free text."""
+        chars = set(self.chars[font])
+        if self.free[font]:
+            for name in self.catalog:
+                chars.update(name)
+        return {ord(c) for c in chars if c > " "}, bool(self.free[font])
+
+
+def generate(project_dir):
+    fonts = sorted(glob.glob(os.path.join(project_dir, "data", "*.vlw")))
+    out_path = os.path.join(project_dir, HEADER_NAME)
+    names = [os.path.splitext(os.path.basename(p))[0] for p in fonts]
+    scan = FontScan(project_dir, names)
+
+    lines = [
+        "// Generated by tools/fonts/vlw2h.py from data/*.vlw - do not edit.",
+        "#ifndef FONTS_VLW_H",
+        "#define FONTS_VLW_H",
+        "",
+        "#include <stddef.h>",
+        "#include <stdint.h>",
+        "",
+    ]
+    table = []
+    summary = []
+    errors = []
+    for path, name in zip(fonts, names):
+        if name not in scan.used:
+            summary.append("%s unused" % name)
+            continue
+        with open(path, "rb") as f:
+            data = f.read()
+        full = len(data)
+        needed, free = scan.needs(name)
+        missing = needed - vlw_codes(data)
+        if missing:
+            errors.append("%s.vlw lacks %s" % (name, "".join(sorted(chr(c) for c in missing))))
+        if not free:
+            data = subset_vlw(data, needed)
+        count = VLW_HEADER.unpack_from(data, 0)[0]
+        summary.append("%s %d glyphs %d->%d bytes%s" % (name, count, full, len(data), " (free text)" if free else ""))
+
+        lines.append("// %s.vlw: %d glyphs, %d bytes (file %d)" % (name, count, len(data), full))
+        lines.append("static const uint8_t %s[] = {" % symbol("kVlw_", name))
+        for i in range(0, len(data), 20):
+            lines.append("  " + ",".join("0x%02x" % b for b in data[i:i + 20]) + ",")
+        lines.append("};")
+        lines.append("")
+        table.append((name, len(data)))
+
+    if errors:
+        sys.exit("vlw2h: glyphs drawn by the sources are missing: " + "; ".join(errors))
+
+    lines += [
+        "struct CompiledFont {",
+        "  const char *name;       // .vlw file name without extension",
+        "  const uint8_t *data;",
+        "  uint32_t size;",
+        "};",
+        "",
+        "static const CompiledFont kCompiledFonts[] = {",
+    ]
+    for name, size in table:
+        lines.append('  {"%s", %s, %d},' % (name, symbol("kVlw_", name), size))
+    if not table:
+        lines.append("  {nullptr, nullptr, 0},")
+    lines += [
+        "};",
+        "static const size_t kCompiledFontCount = %d;" % len(table),
+        "",
+        "#endif // FONTS_VLW_H",
+    ]
+
+    content = "\n".join(lines) + "\n"
+    if os.path.exists(out_path):
+        with open(out_path) as f:
+            if f.read() == content:
+                return
+    with open(out_path, "w") as f:
+        f.write(content)
+    print("vlw2h: " + ", ".join(summary) + " -> " + HEADER_NAME)
+
+
+try:
+    Import("env")  # noqa: F821 - defined when run as a PlatformIO pre: script
+    generate(env.subst("$PROJECT_DIR"))  # noqa: F821
+except NameError:
+    if __name__ == "__main__":
+        here = os.path.dirname(os.path.abspath(__file__))
+        generate(os.path.normpath(os.path.join(here, "..", "..")))
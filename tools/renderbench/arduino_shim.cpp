@@ -0,0 +1,150 @@
+// Arduino-ESP32 core shim (see shim/Arduino.h): virtual clock, pins,
+// Serial and the library globals main.cpp links against.
+#include <Arduino.h>
+#include <ArduinoOTA.h>
+#include <LittleFS.h>
+#include <WiFi.h>
+#include <Wire.h>
+#include <esp_sntp.h>
+
+#undef time
+#undef gettimeofday
+
+HardwareSerial Serial;
+EspClass ESP;
+fs::FS LittleFS;
+WiFiClass WiFi;
+ArduinoOTAClass ArduinoOTA;
+TwoWire Wire;
+bool shimSensorPresent = true;
+
+// =========================
+// Virtual Clock
+// =========================
+static uint64_t nowUs = 0;         // Monotonic (millis/micros)
+static int64_t wallOffsetUs = 0;   // Wall clock = nowUs + wallOffsetUs
+static uint32_t pendingNotify = 0; // Task notifications not yet taken
+static sntp_sync_time_cb_t syncCallback = nullptr;
+
+uint64_t shimNowUs() {
+  return nowUs;
+}
+
+void shimAdvanceUs(uint64_t us) {
+  nowUs += us;
+}
+
+void shimSetWallTime(time_t sec, uint32_t us) {
+  wallOffsetUs = (int64_t)sec * 1000000 + us - (int64_t)nowUs;
+}
+
+time_t shimTime(time_t *out) {
+  time_t sec = (time_t)(((int64_t)nowUs + wallOffsetUs) / 1000000);
+  if (out) *out = sec;
+  return sec;
+}
+
+int shimGettimeofday(struct timeval *tv, void *) {
+  int64_t wall = (int64_t)nowUs + wallOffsetUs;
+  tv->tv_sec = (time_t)(wall / 1000000);
+  tv->tv_usec = (suseconds_t)(wall % 1000000);
+  return 0;
+}
+
+// Blocks "until notified or timeout": nothing else runs, so it's the timeout
+// unless a notification is already pending
+uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t ticks) {
+  if (pendingNotify > 0) {
+    uint32_t taken = pendingNotify;
+    pendingNotify = clear ? 0 : pendingNotify - 1;
+    return taken;
+  }
+  shimAdvanceUs((uint64_t)ticks * 1000);
+  return 0;
+}
+
+void shimNotifyLoop() {
+  pendingNotify++;
+}
+
+void sntp_set_time_sync_notification_cb(sntp_sync_time_cb_t callback) {
+  syncCallback = callback;
+}
+
+// "Syncs" at once: the wall clock is whatever shimSetWallTime() set
+void configTzTime(const char *tz, const char *, const char *, const char *) {
+  setenv("TZ", tz, 1);
+  tzset();
+  if (syncCallback != nullptr) {
+    struct timeval tv;
+    shimGettimeofday(&tv, nullptr);
+    syncCallback(&tv);
+  }
+}
+
+bool getLocalTime(struct tm *info, uint32_t) {
+  time_t now = shimTime(nullptr);
+  localtime_r(&now, info);
+  return info->tm_year > (2016 - 1900);
+}
+
+// =========================
+// Pins / libc
+// =========================
+static uint8_t pinLevels[64];
+static bool pinsInitialised = false;
+
+void shimSetPin(int pin, int level) {
+  if (!pinsInitialised) {
+    memset(pinLevels, HIGH, sizeof(pinLevels));
+    pinsInitialised = true;
+  }
+  if (pin >= 0 && pin < 64) pinLevels[pin] = (uint8_t)level;
+}
+
+int digitalRead(int pin) {
+  if (!pinsInitialised || pin < 0 || pin >= 64) return HIGH;
+  return pinLevels[pin];
+}
+
+size_t shimStrlcpy(char *dst, const char *src, size_t size) {
+  size_t len = strlen(src);
+  if (size > 0) {
+    size_t n = len < size - 1 ? len : size - 1;
+    memcpy(dst, src, n);
+    dst[n] = '\0';
+  }
+  return len;
+}
+
+// =========================
+// Serial
+// =========================
+static bool serialEnabled() {
+  static int enabled = -1;
+  if (enabled < 0) enabled = getenv("RENDERBENCH_SERIAL") != nullptr;
+  return enabled;
+}
+
+size_t HardwareSerial::out(const char *format, ...) {
+  if (!serialEnabled()) return 0;
+  va_list args;
+  va_start(args, format);
+  int n = vprintf(format, args);
+  va_end(args);
+  return n > 0 ? (size_t)n : 0;
+}
+
+size_t HardwareSerial::printf(const char *format, ...) {
+  if (!serialEnabled()) return 0;
+  va_list args;
+  va_start(args, format);
+  int n = vprintf(format, args);
+  va_end(args);
+  return n > 0 ? (size_t)n : 0;
+}
+
+size_t HardwareSerial::write(const uint8_t *buf, size_t len) {
+  if (!serialEnabled()) return 0;
+  return fwrite(buf, 1, len, stdout);
+}
@@ -0,0 +1,138 @@
+// PNG I/O for renderbench (see png_io.h). Writes filter 0 rows; reads any
+// filter so goldens re-saved by other tools still load.
+#include "png_io.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <zlib.h>
+
+static const uint8_t kSignature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+
+static void putBe32(std::vector<uint8_t> &out, uint32_t v) {
+  out.push_back(v >> 24);
+  out.push_back(v >> 16);
+  out.push_back(v >> 8);
+  out.push_back(v);
+}
+
+static uint32_t getBe32(const uint8_t *p) {
+  return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static void putChunk(std::vector<uint8_t> &out, const char *type, const std::vector<uint8_t> &data) {
+  putBe32(out, (uint32_t)data.size());
+  size_t start = out.size();
+  out.insert(out.end(), type, type + 4);
+  out.insert(out.end(), data.begin(), data.end());
+  uint32_t crc = crc32(0, out.data() + start, (uInt)(out.size() - start));
+  putBe32(out, crc);
+}
+
+bool writePng(const char *path, const RgbImage &image) {
+  std::vector<uint8_t> raw;
+  raw.reserve((size_t)image.height * (image.width * 3 + 1));
+  for (int y = 0; y < image.height; y++) {
+    raw.push_back(0);  // Filter: none
+    const uint8_t *row = image.rgb.data() + (size_t)y * image.width * 3;
+    raw.insert(raw.end(), row, row + image.width * 3);
+  }
+  uLongf packedSize = compressBound((uLong)raw.size());
+  std::vector<uint8_t> packed(packedSize);
+  if (compress2(packed.data(), &packedSize, raw.data(), (uLong)raw.size(), 9) != Z_OK) return false;
+  packed.resize(packedSize);
+
+  std::vector<uint8_t> ihdr;
+  putBe32(ihdr, (uint32_t)image.width);
+  putBe32(ihdr, (uint32_t)image.height);
+  ihdr.push_back(8);  // Bit depth
+  ihdr.push_back(2);  // Colour type: RGB
+  ihdr.push_back(0);
+  ihdr.push_back(0);
+  ihdr.push_back(0);
+
+  std::vector<uint8_t> file(kSignature, kSignature + 8);
+  putChunk(file, "IHDR", ihdr);
+  putChunk(file, "IDAT", packed);
+  putChunk(file, "IEND", std::vector<uint8_t>());
+
+  FILE *f = fopen(path, "wb");
+  if (!f) return false;
+  bool ok = fwrite(file.data(), 1, file.size(), f) == file.size();
+  return (fclose(f) == 0) && ok;
+}
+
+static uint8_t paeth(int a, int b, int c) {
+  int p = a + b - c;
+  int pa = abs(p - a), pb = abs(p - b), pc = abs(p - c);
+  if (pa <= pb && pa <= pc) return (uint8_t)a;
+  return (uint8_t)(pb <= pc ? b : c);
+}
+
+bool readPng(const char *path, RgbImage *image) {
+  FILE *f = fopen(path, "rb");
+  if (!f) return false;
+  std::vector<uint8_t> file;
+  uint8_t buf[65536];
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), f)) > 0) file.insert(file.end(), buf, buf + n);
+  fclose(f);
+  if (file.size() < 8 || memcmp(file.data(), kSignature, 8) != 0) return false;
+
+  int width = 0, height = 0, channels = 0;
+  std::vector<uint8_t> packed;
+  for (size_t p = 8; p + 12 <= file.size();) {
+    uint32_t len = getBe32(&file[p]);
+    const uint8_t *type = &file[p + 4];
+    const uint8_t *data = &file[p + 8];
+    if (p + 12 + len > file.size()) return false;
+    if (memcmp(type, "IHDR", 4) == 0) {
+      width = (int)getBe32(data);
+      height = (int)getBe32(data + 4);
+      if (data[8] != 8 || data[12] != 0) return false;  // 8-bit, not interlaced
+      channels = data[9] == 2 ? 3 : data[9] == 6 ? 4 : 0;
+      if (channels == 0) return false;
+    } else if (memcmp(type, "IDAT", 4) == 0) {
+      packed.insert(packed.end(), data, data + len);
+    }
+    p += 12 + len;
+  }
+  if (width <= 0 || height <= 0) return false;
+
+  size_t stride = (size_t)width * channels;
+  std::vector<uint8_t> raw((stride + 1) * height);
+  uLongf rawSize = (uLongf)raw.size();
+  if (uncompress(raw.data(), &rawSize, packed.data(), (uLong)packed.size()) != Z_OK || rawSize != raw.size()) {
+    return false;
+  }
+
+  // Undo the per-row filters in place
+  for (int y = 0; y < height; y++) {
+    uint8_t filter = raw[y * (stride + 1)];
+    uint8_t *row = &raw[y * (stride + 1) + 1];
+    const uint8_t *prev = y > 0 ? &raw[(y - 1) * (stride + 1) + 1] : nullptr;
+    for (size_t i = 0; i < stride; i++) {
+      int a = i >= (size_t)channels ? row[i - channels] : 0;
+      int b = prev ? prev[i] : 0;
+      int c = (prev && i >= (size_t)channels) ? prev[i - channels] : 0;
+      switch (filter) {
+        case 1: row[i] += a; break;
+        case 2: row[i] += b; break;
+        case 3: row[i] += (a + b) / 2; break;
+        case 4: row[i] += paeth(a, b, c); break;
+        default: break;
+      }
+    }
+  }
+
+  image->width = width;
+  image->height = height;
+  image->rgb.resize((size_t)width * height * 3);
+  for (int y = 0; y < height; y++) {
+    const uint8_t *row = &raw[y * (stride + 1) + 1];
+    for (int x = 0; x < width; x++) {
+      memcpy(&image->rgb[((size_t)y * width + x) * 3], row + (size_t)x * channels, 3);
+    }
+  }
+  return true;
+}
@@ -0,0 +1,18 @@
+// Minimal 8-bit RGB PNG read/write (zlib) for renderbench goldens.
+#ifndef RENDERBENCH_PNG_IO_H
+#define RENDERBENCH_PNG_IO_H
+
+#include <stdint.h>
+
+#include <vector>
+
+struct RgbImage {
+  int width = 0;
+  int height = 0;
+  std::vector<uint8_t> rgb;  // width * height * 3, rows top-down
+};
+
+bool writePng(const char *path, const RgbImage &image);
+bool readPng(const char *path, RgbImage *image);  // 8-bit RGB/RGBA only
+
+#endif // RENDERBENCH_PNG_IO_H
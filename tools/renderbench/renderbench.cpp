@@ -0,0 +1,766 @@
+// renderbench: host build of the firmware's render path against an in-memory
+// RGB565 framebuffer (shim/TFT_eSPI.h), with golden-image checks and frame
+// timing.
+//
+// Build & run (PlatformIO native env, Linux/macOS, from the repo root):
+//   pio run -e native_render && .pio/build/native_render/program      # check + bench
+//   .pio/build/native_render/program --update                         # rewrite goldens
+//   .pio/build/native_render/program --year 2026                      # year simulation
+//
+// src/main.cpp is compiled unchanged (included below, so the driver can see
+// its file-local state) on top of shims for the Arduino core and libraries.
+// Time is virtual: setup() and loop() run exactly as on the device, but
+// ulTaskNotifyTake() just advances the clock to the requested wake, so every
+// run draws the same pixels.
+//
+// Check: each screen mode is rendered at a fixed instant and compared pixel
+// for pixel with tools/renderbench/golden/<mode>.png. On a mismatch the
+// frame and a diff (changed pixels in red) are written to the current
+// directory as <mode>.actual.png / <mode>.diff.png and the exit code is 1.
+//
+// Bench: each mode is brought back to its instant and runs on for --seconds
+// of virtual time. Every loop pass that touched the panel counts as a frame;
+// host time per frame plus pixels and windows (primitive calls / sprite
+// pushes) written per frame are reported, and each static layer's repaint
+// is measured twice: drawn (capturing its layer cache), then restored, as
+// is a portrait flip slide (frames, duration, scroll back at line 0).
+// Host microseconds aren't ESP32 microseconds, but pixel counts are exact
+// and relative timings track render-path changes.
+//
+// Year (--year): see "Year Simulation" below.
+#include <algorithm>
+#include <chrono>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "png_io.h"
+
+#include "../../src/main.cpp"
+
+static const time_t kFirstInstant = 1773530812;  // 2026-03-14 23:26:52 UTC
+static const char *goldenDir = "tools/renderbench/golden";
+
+struct Scenario {
+  const char *name;
+  int32_t offsetSec;  // Capture instant, from kFirstInstant
+  bool landscape;
+  bool alternate;     // Portrait with the sensor screen rotation showing it
+  bool diagnostics;   // Touch once after the instant (page 1)
+  const char *homeLabel;  // nullptr: the configured home city
+  bool uncached;      // Paint the layers as if over the cache budget
+};
+
+// Even seconds show the colon, odd ones hide it: cover both
+static const Scenario kScenarios[] = {
+  {"portrait", 0, false, false, false, nullptr, false},
+  {"portrait_alternate", 120, false, true, false, nullptr, false},
+  {"landscape", 241, true, false, false, nullptr, false},
+  {"diagnostics", 360, false, false, true, nullptr, false},
+};
+
+// Variants of a mode, golden check only. A home label of the full 31
+// characters must reach the alternate screen's "Home: CITY" header whole;
+// layers drawn straight to the panel (no cache) must match the cached ones.
+static const Scenario kVariants[] = {
+  {"alternate_long_home", 120, false, true, false, "Llanfairpwllgwyngyllgogerychwyr", false},
+  {"portrait_uncached", 0, false, false, false, nullptr, true},
+  {"landscape_uncached", 241, true, false, false, nullptr, true},
+};
+
+static char configuredHomeLabel[sizeof(config.homeCityLabel)];  // As loaded by setup()
+
+struct FrameStats {
+  uint32_t frames = 0;
+  uint64_t hostUs = 0;
+  uint64_t maxHostUs = 0;
+  uint64_t pixels = 0;
+  uint64_t windows = 0;
+};
+
+static uint64_t wallUsNow() {
+  struct timeval tv;
+  shimGettimeofday(&tv, nullptr);
+  return (uint64_t)tv.tv_sec * 1000000 + tv.tv_usec;
+}
+
+// One loop() pass, timed; a pass that wrote to the panel is a frame
+static void timedLoop(FrameStats *stats) {
+  uint64_t pixels = tft.pixelsWritten;
+  uint64_t windows = tft.windows;
+  auto start = std::chrono::steady_clock::now();
+  loop();
+  uint64_t us = (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - start).count();
+  if (stats == nullptr || tft.pixelsWritten == pixels) return;
+  stats->frames++;
+  stats->hostUs += us;
+  if (us > stats->maxHostUs) stats->maxHostUs = us;
+  stats->pixels += tft.pixelsWritten - pixels;
+  stats->windows += tft.windows - windows;
+}
+
+// Run loop() until the wall clock reaches untilUs. The pass that draws a
+// second ends by waiting for the next one, so stopping half-way through
+// second T leaves T on the panel.
+static void runUntil(uint64_t untilUs, FrameStats *stats) {
+  while (wallUsNow() < untilUs) {
+    timedLoop(stats);
+  }
+}
+
+static void touch() {
+  shimSetPin(XPT2046_IRQ, LOW);
+  shimNotifyLoop();
+  loop();
+  shimSetPin(XPT2046_IRQ, HIGH);
+  shimNotifyLoop();
+  loop();
+}
+
+// Configure the mode the way handlePostConfig() applies a change
+static void selectMode(const Scenario &s) {
+  showingDiagnostics = false;
+  strlcpy(config.homeCityLabel, s.homeLabel ? s.homeLabel : configuredHomeLabel,
+          sizeof(config.homeCityLabel));  // applyRotation() drops the cached layers
+  config.landscapeMode = s.landscape;
+  config.enableScreenRotation = s.alternate;
+  showingAlternateScreen = false;
+  lastScreenFlip = millis();
+  if (s.alternate) {
+    lastScreenFlip -= config.screenFlipInterval * 1000UL;  // Flip on the next tick
+  }
+  applyRotation();
+  for (LayerCache &lc : layerCaches) {
+    lc.overflow = s.uncached;  // Cleared again by the next applyRotation()
+  }
+  drawStaticLayout();
+  updateAllCityTimes();
+}
+
+static RgbImage captureFrame() {
+  RgbImage image;
+  image.width = tft.width();
+  image.height = tft.height();
+  image.rgb.resize((size_t)image.width * image.height * 3);
+  // What the panel shows: inside the scroll area, memory lines from the
+  // vertical scroll start (portrait only; rotation 2 stores rows bottom-up)
+  const std::vector<uint16_t> &fb = tft.framebuffer();
+  const int rows = image.height;
+  const bool scrolled = !(tft.getRotation() & 1) && tft.scrollLines > 0;
+  const int top = tft.scrollTop, lines = tft.scrollLines;
+  for (size_t i = 0; i < fb.size(); i++) {
+    int y = (int)(i / image.width);
+    int line = (tft.getRotation() == 2) ? rows - 1 - y : y;  // Panel line
+    if (scrolled && line >= top && line < top + lines) {
+      line = top + (line - top + tft.scrollStart - top + lines) % lines;
+    }
+    int shown = (tft.getRotation() == 2) ? rows - 1 - line : line;
+    uint16_t c = fb[(size_t)shown * image.width + i % image.width];
+    image.rgb[i * 3 + 0] = ((c >> 11) & 0x1F) << 3;  // Same expansion as /api/snapshot
+    image.rgb[i * 3 + 1] = ((c >> 5) & 0x3F) << 2;
+    image.rgb[i * 3 + 2] = (c & 0x1F) << 3;
+  }
+  return image;
+}
+
+// Mode s as it stands half-way through its capture instant
+static RgbImage renderScenario(const Scenario &s) {
+  time_t instant = kFirstInstant + s.offsetSec;
+  shimSetWallTime(instant - 3, 0);
+  selectMode(s);
+  runUntil((uint64_t)instant * 1000000 + 500000, nullptr);
+  if (s.diagnostics) touch();
+  return captureFrame();
+}
+
+// Compare with the golden; false (and actual/diff PNGs written) on mismatch
+static bool checkGolden(const char *name, const RgbImage &actual) {
+  char path[256];
+  snprintf(path, sizeof(path), "%s/%s.png", goldenDir, name);
+  RgbImage golden;
+  if (!readPng(path, &golden)) {
+    printf("  %-20s FAIL: cannot read %s (run with --update)\n", name, path);
+    return false;
+  }
+  if (golden.width != actual.width || golden.height != actual.height) {
+    printf("  %-20s FAIL: size %dx%d, golden %dx%d\n", name, actual.width, actual.height, golden.width,
+           golden.height);
+    return false;
+  }
+
+  RgbImage diff = actual;
+  int changed = 0, x0 = actual.width, y0 = actual.height, x1 = -1, y1 = -1;
+  for (int y = 0; y < actual.height; y++) {
+    for (int x = 0; x < actual.width; x++) {
+      size_t i = ((size_t)y * actual.width + x) * 3;
+      bool same = memcmp(&actual.rgb[i], &golden.rgb[i], 3) == 0;
+      uint8_t grey = (uint8_t)((actual.rgb[i] + actual.rgb[i + 1] + actual.rgb[i + 2]) / 12);
+      diff.rgb[i + 0] = same ? grey : 255;
+      diff.rgb[i + 1] = same ? grey : 0;
+      diff.rgb[i + 2] = same ? grey : 0;
+      if (same) continue;
+      changed++;
+      x0 = min(x0, x);
+      y0 = min(y0, y);
+      x1 = max(x1, x);
+      y1 = max(y1, y);
+    }
+  }
+  if (changed == 0) {
+    printf("  %-20s ok\n", name);
+    return true;
+  }
+
+  printf("  %-20s FAIL: %d pixels differ in (%d,%d)-(%d,%d)\n", name, changed, x0, y0, x1, y1);
+  snprintf(path, sizeof(path), "%s.actual.png", name);
+  writePng(path, actual);
+  snprintf(path, sizeof(path), "%s.diff.png", name);
+  writePng(path, diff);
+  return false;
+}
+
+static void printFrameStats(const char *name, const FrameStats &s) {
+  if (s.frames == 0) {
+    printf("  %-20s no frames\n", name);
+    return;
+  }
+  printf("  %-20s %7u %10.1f %10llu %11llu %9llu\n", name, s.frames, (double)s.hostUs / s.frames,
+         (unsigned long long)s.maxHostUs, (unsigned long long)(s.pixels / s.frames),
+         (unsigned long long)(s.windows / s.frames));
+}
+
+// One full repaint of the current mode's static layout (banded, as on the device)
+static void benchLayout(const char *name, void (*draw)()) {
+  uint64_t pixels = tft.pixelsWritten;
+  uint64_t windows = tft.windows;
+  auto start = std::chrono::steady_clock::now();
+  draw();
+  finishStaticLayout();
+  uint64_t us = (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::steady_clock::now() - start).count();
+  printf("  %-27s %10.1f %11llu %9llu\n", name, (double)us,
+         (unsigned long long)(tft.pixelsWritten - pixels), (unsigned long long)(tft.windows - windows));
+}
+
+static void drawAlternateLayout() {
+  drawAlternatePortraitStatic();
+}
+
+// A portrait flip as loop() does it (slide at SLIDE_FPS where supported),
+// run to completion; false if the scroll start isn't back at line 0
+static bool benchSlide(const char *name, StaticLayer layer) {
+  FrameStats stats;
+  uint32_t scrolls = tft.scrollSets;
+  showingAlternateScreen = (layer == LAYER_ALTERNATE);
+  lastScreenFlip = millis();  // No flip of loop()'s own during the slide
+  slideStaticLayout(layer);
+  while (staticLayoutPending()) {
+    timedLoop(&stats);
+  }
+  bool home = tft.scrollStart == 0;
+  printf("  %-27s %7u %10.1f %10llu %9u %8u %s\n", name, stats.frames,
+         stats.frames ? (double)stats.hostUs / stats.frames : 0.0, (unsigned long long)stats.maxHostUs,
+         slideLastMs, tft.scrollSets - scrolls, home ? "" : "FAIL: scroll not reset");
+  return home;
+}
+
+// Diagnostics page 1 left open while a log entry arrives every second; the
+// panel must then show what a fresh draw of the page shows (appends and
+// scroll area vs. the plain layout). Without a scroll area the log is a
+// ring: its line i is the fresh draw's line i - head.
+static bool benchConsole(const char *name, const Scenario &s, int seconds) {
+  renderScenario(s);
+  FrameStats stats;
+  uint32_t scrolls = diagLogScrolls;
+  for (int i = 0; i < seconds; i++) {
+    char msg[40];
+    snprintf(msg, sizeof(msg), "Console entry %d\n", i);
+    addToLogBuffer(i % 3 == 0 ? DBG_LEVEL_WARN : DBG_LEVEL_INFO, msg);
+    runUntil(wallUsNow() + 1000000, &stats);
+  }
+  refreshDiagnosticsScreen();  // Uptime follows millis(), not the wall second
+  RgbImage live = captureFrame();
+  const int ringHead = diagLogScroll ? 0 : diagLogHead;
+  drawDiagnosticsScreen();
+  RgbImage fresh = captureFrame();
+  const int top = diagLogTop, rows = diagLogRows;
+  const size_t stride = (size_t)live.width * 3;
+  int changed = 0;
+  for (int y = 0; y < live.height; y++) {
+    int fy = y;
+    if (y >= top && y < top + rows * kDiagLineHeight) {
+      int line = (y - top) / kDiagLineHeight;
+      fy = top + (line - ringHead + rows) % rows * kDiagLineHeight + (y - top) % kDiagLineHeight;
+    }
+    for (int x = 0; x < live.width; x++) {
+      if (memcmp(&live.rgb[y * stride + x * 3], &fresh.rgb[fy * stride + x * 3], 3) != 0) changed++;
+    }
+  }
+  printf("  %-20s %7u %10.1f %10llu %11llu %9u %s\n", name, stats.frames,
+         stats.frames ? (double)stats.hostUs / stats.frames : 0.0, (unsigned long long)stats.maxHostUs,
+         stats.frames ? (unsigned long long)(stats.pixels / stats.frames) : 0ULL, diagLogScrolls - scrolls,
+         changed ? "FAIL: differs from a fresh draw" : "");
+  if (changed) {
+    char path[64];
+    snprintf(path, sizeof(path), "%s.live.png", name);
+    writePng(path, live);
+    snprintf(path, sizeof(path), "%s.fresh.png", name);
+    writePng(path, fresh);
+  }
+  return changed == 0;
+}
+
+// =========================
+// Year Simulation (--year)
+// =========================
+// Fast-forwards loop() through a calendar year on the virtual clock and
+// checks what the widgets drew against libc localtime_r() (TZ set to each
+// city's POSIX string):
+//   - zone sweep: every timezones[] entry, five at a time as the remote
+//     cities (portrait), drawn one second before and at each of its DST
+//     transitions and local midnights and the home city's
+//   - year run: the default configuration (screen rotation on, so both
+//     portrait screens), every second of --days days, checked at each
+//     minute boundary and the second before it; per-day frames, draw
+//     windows, pixels, smooth font loads and heap allocations are reported
+// Heap allocations are operator new calls (sprite buffers, containers);
+// Arduino String always allocates where the shim's std::string may not.
+
+static uint64_t heapAllocs = 0;
+
+void *operator new(size_t size) {
+  heapAllocs++;
+  void *p = malloc(size ? size : 1);
+  if (p == nullptr) throw std::bad_alloc();
+  return p;
+}
+void *operator new[](size_t size) { return operator new(size); }
+void operator delete(void *p) noexcept { free(p); }
+void operator delete[](void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+void operator delete[](void *p, size_t) noexcept { free(p); }
+
+// libc local time for a POSIX TZ string
+static void referenceLocal(const char *tz, time_t utc, struct tm *out) {
+  static std::string current;
+  if (current != tz) {
+    setenv("TZ", tz, 1);
+    tzset();
+    current = tz;
+  }
+  localtime_r(&utc, out);
+}
+
+static const char *cityTz(int city) {
+  return city == 0 ? config.homeCityTz : config.remoteTzStrings[city - 1];
+}
+
+static const char *cityLabel(int city) {
+  return city == 0 ? config.homeCityLabel : config.remoteCities[city - 1];
+}
+
+static uint64_t widgetChecks = 0;
+static uint32_t checkFailures = 0;
+
+static void formatUtc(time_t t, char *out, size_t len) {
+  struct tm utc;
+  gmtime_r(&t, &utc);
+  strftime(out, len, "%Y-%m-%d %H:%M:%S UTC", &utc);
+}
+
+// Compare every drawn city time, day note and the date with libc at second t
+static bool checkWidgets(time_t t) {
+  struct tm local[MAX_CITIES];
+  for (int city = 0; city < cityCount(); city++) {
+    referenceLocal(cityTz(city), t, &local[city]);
+  }
+  bool ok = true;
+  for (int i = 0; i < widgetCount; i++) {
+    const TextWidget &wd = widgets[i];
+    if (!wd.valid) continue;
+    int city = (wd.row == 0) ? 0 : cityForRemoteRow(wd.row - 1);
+    if (city < 0 && wd.source != SRC_DATE) continue;
+    char want[32];
+    const struct tm &lt = local[city < 0 ? 0 : city];
+    int dayDiff = (lt.tm_year != local[0].tm_year) ? lt.tm_year - local[0].tm_year
+                                                   : lt.tm_yday - local[0].tm_yday;
+    switch (wd.source) {
+      case SRC_CITY_TIME:
+        snprintf(want, sizeof(want), "%02d:%02d", lt.tm_hour, lt.tm_min);
+        if (wd.blink && (t % 2) != 0) want[2] = ' ';
+        break;
+      case SRC_CITY_NOTE:
+        if (dayDiff < 0) {
+          strlcpy(want, wd.upperNote ? "PREV DAY" : "Prev Day", sizeof(want));
+        } else if (dayDiff > 0) {
+          strlcpy(want, wd.upperNote ? "NEXT DAY" : "Next Day", sizeof(want));
+        } else {
+          strlcpy(want, city == 0 ? "HOME" : "", sizeof(want));
+        }
+        break;
+      case SRC_DATE:
+        strftime(want, sizeof(want), "%a %d %b", &local[0]);
+        for (char *p = want; *p; p++) *p = (char)toupper((unsigned char)*p);
+        break;
+      default:
+        continue;
+    }
+    widgetChecks++;
+    if (strcmp(want, wd.text) == 0) continue;
+    ok = false;
+    if (checkFailures++ < 20) {
+      char when[32];
+      formatUtc(t, when, sizeof(when));
+      printf("  MISMATCH %s: %s (%s) drew \"%s\", libc \"%s\"\n", when, cityLabel(city < 0 ? 0 : city),
+             cityTz(city < 0 ? 0 : city), wd.text, want);
+    }
+  }
+  return ok;
+}
+
+// Run loop() until a pass draws second t; false if the clock went past it
+static bool drawSecond(time_t t) {
+  for (int guard = 0; guard < 1000; guard++) {
+    time_t sec = shimTime(nullptr);
+    if (sec > t) return false;
+    time_t before = lastDisplaySecond;
+    loop();
+    if (sec == t && lastDisplaySecond == t && before != t) return true;
+  }
+  return false;
+}
+
+// First second in (lo, hi] whose key differs from lo's (key(lo) != key(hi))
+template <typename Key>
+static time_t bisectChange(const char *tz, time_t lo, time_t hi, Key key) {
+  struct tm tm;
+  referenceLocal(tz, lo, &tm);
+  long loKey = key(tm);
+  while (hi - lo > 1) {
+    time_t mid = lo + (hi - lo) / 2;
+    referenceLocal(tz, mid, &tm);
+    if (key(tm) == loKey) {
+      lo = mid;
+    } else {
+      hi = mid;
+    }
+  }
+  return hi;
+}
+
+// Instants in [from, to) where the zone's UTC offset or local date changes
+static void zoneEvents(const char *tz, time_t from, time_t to, std::vector<time_t> *out) {
+  auto offset = [](const struct tm &tm) { return (long)tm.tm_gmtoff; };
+  auto date = [](const struct tm &tm) { return (long)tm.tm_year * 1000 + tm.tm_yday; };
+  struct tm tm;
+  referenceLocal(tz, from, &tm);
+  long lastOffset = offset(tm), lastDate = date(tm);
+  for (time_t t = from + 3600; t < to + 3600; t += 3600) {
+    referenceLocal(tz, t, &tm);
+    if (offset(tm) != lastOffset) out->push_back(bisectChange(tz, t - 3600, t, offset));
+    if (date(tm) != lastDate) out->push_back(bisectChange(tz, t - 3600, t, date));
+    referenceLocal(tz, t, &tm);
+    lastOffset = offset(tm);
+    lastDate = date(tm);
+  }
+}
+
+static void applyCities() {
+  parseAllTimezones();
+  drawStaticLayout();
+  updateAllCityTimes();
+}
+
+// Every timezones[] entry as a remote city, around each of its (and the
+// home city's) offset changes and midnights
+static bool runZoneSweep(time_t yearStart, time_t yearEnd) {
+  config.landscapeMode = false;
+  config.enableScreenRotation = false;
+  showingAlternateScreen = false;
+  showingDiagnostics = false;
+  applyRotation();
+
+  uint32_t instants = 0, missed = 0;
+  uint64_t checksBefore = widgetChecks;
+  uint32_t failuresBefore = checkFailures;
+  auto start = std::chrono::steady_clock::now();
+  for (int first = 0; first < numTimezones; first += REMOTE_ROWS_PER_PAGE) {
+    config.remoteCount = REMOTE_ROWS_PER_PAGE;
+    for (int r = 0; r < REMOTE_ROWS_PER_PAGE; r++) {
+      const TimezoneInfo &zone = timezones[(first + r) % numTimezones];
+      strlcpy(config.remoteCities[r], zone.name, sizeof(config.remoteCities[r]));
+      strlcpy(config.remoteTzStrings[r], zone.tzString, sizeof(config.remoteTzStrings[r]));
+    }
+    shimSetWallTime(yearStart - 10);
+    applyCities();
+
+    std::vector<time_t> events;
+    for (int city = 0; city < cityCount(); city++) {
+      zoneEvents(cityTz(city), yearStart, yearEnd, &events);
+    }
+    std::sort(events.begin(), events.end());
+    events.erase(std::unique(events.begin(), events.end()), events.end());
+
+    for (time_t t : events) {
+      if (shimTime(nullptr) < t - 1) shimSetWallTime(t - 1, 0);
+      if (shimTime(nullptr) == t - 1) {
+        if (drawSecond(t - 1)) {
+          checkWidgets(t - 1);
+        } else {
+          missed++;
+        }
+      }
+      if (drawSecond(t)) {
+        checkWidgets(t);
+      } else {
+        missed++;
+      }
+      instants++;
+    }
+  }
+  double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  uint32_t failures = checkFailures - failuresBefore;
+  printf("Zone sweep: %d zones, %u instants, %llu widget checks, %u mismatches, %u not drawn (%.1f s)\n",
+         numTimezones, instants, (unsigned long long)(widgetChecks - checksBefore), failures, missed, secs);
+  return failures == 0 && missed == 0;
+}
+
+struct DayStats {
+  uint32_t frames = 0;
+  uint64_t windows = 0;
+  uint64_t pixels = 0;
+  uint32_t fontLoads = 0;
+  uint64_t allocs = 0;
+  uint64_t hostUs = 0;
+};
+
+static void printDayRow(const char *label, const DayStats &sum, int days) {
+  printf("  %-8s %4d %9.0f %10.0f %12.0f %8.1f %9.1f %9.1f\n", label, days, (double)sum.frames / days,
+         (double)sum.windows / days, (double)sum.pixels / days, (double)sum.fontLoads / days,
+         (double)sum.allocs / days, sum.hostUs / 1000.0 / days);
+}
+
+// The default configuration, second by second, for days days from yearStart
+static bool runYear(time_t yearStart, int days) {
+  loadConfig();
+  config.landscapeMode = false;
+  showingAlternateScreen = false;
+  showingDiagnostics = false;
+  applyRotation();
+  shimSetWallTime(yearStart - 10);
+  applyCities();
+  lastScreenFlip = millis();
+
+  uint64_t checksBefore = widgetChecks;
+  uint32_t failuresBefore = checkFailures;
+  std::vector<DayStats> perDay(days);
+  auto start = std::chrono::steady_clock::now();
+  for (int d = 0; d < days; d++) {
+    DayStats &day = perDay[d];
+    uint64_t dayEndUs = (uint64_t)(yearStart + (time_t)(d + 1) * 86400) * 1000000;
+    uint32_t fontLoadsBefore = fontLoads;
+    while (wallUsNow() < dayEndUs) {
+      time_t sec = shimTime(nullptr);
+      time_t before = lastDisplaySecond;
+      uint64_t pixels = tft.pixelsWritten;
+      uint64_t windows = tft.windows;
+      uint64_t allocs = heapAllocs;
+      auto passStart = std::chrono::steady_clock::now();
+      loop();
+      day.hostUs += (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+                        std::chrono::steady_clock::now() - passStart).count();
+      day.allocs += heapAllocs - allocs;
+      if (tft.pixelsWritten != pixels) {
+        day.frames++;
+        day.pixels += tft.pixelsWritten - pixels;
+        day.windows += tft.windows - windows;
+      }
+      int inMinute = (int)(sec % 60);
+      if (lastDisplaySecond == sec && before != sec && (inMinute == 0 || inMinute == 59)) {
+        checkWidgets(sec);
+      }
+    }
+    day.fontLoads = fontLoads - fontLoadsBefore;
+  }
+  double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  printf("\nYear run: %d days, default cities, per day (averaged over each month):\n", days);
+  printf("  %-8s %4s %9s %10s %12s %8s %9s %9s\n", "month", "days", "draws", "windows", "pixels",
+         "fonts", "allocs", "host ms");
+  DayStats month, total, worst;
+  int monthDays = 0;
+  int lastMonth = -1;
+  char label[16] = "";
+  for (int d = 0; d <= days; d++) {
+    struct tm utc;
+    time_t dayStart = yearStart + (time_t)d * 86400;
+    gmtime_r(&dayStart, &utc);
+    if (monthDays > 0 && (d == days || utc.tm_mon != lastMonth)) {
+      printDayRow(label, month, monthDays);
+      month = DayStats();
+      monthDays = 0;
+    }
+    if (d == days) break;
+    lastMonth = utc.tm_mon;
+    strftime(label, sizeof(label), "%Y-%m", &utc);
+    const DayStats &day = perDay[d];
+    for (DayStats *s : {&month, &total}) {
+      s->frames += day.frames;
+      s->windows += day.windows;
+      s->pixels += day.pixels;
+      s->fontLoads += day.fontLoads;
+      s->allocs += day.allocs;
+      s->hostUs += day.hostUs;
+    }
+    worst.frames = max(worst.frames, day.frames);
+    worst.windows = max(worst.windows, day.windows);
+    worst.pixels = max(worst.pixels, day.pixels);
+    worst.fontLoads = max(worst.fontLoads, day.fontLoads);
+    worst.allocs = max(worst.allocs, day.allocs);
+    worst.hostUs = max(worst.hostUs, day.hostUs);
+    monthDays++;
+  }
+  printDayRow("average", total, days);
+  printDayRow("worst", worst, 1);
+
+  uint32_t failures = checkFailures - failuresBefore;
+  printf("  %llu widget checks, %u mismatches; %.1f simulated days per host second (%.1f s)\n",
+         (unsigned long long)(widgetChecks - checksBefore), failures, days / secs, secs);
+  return failures == 0;
+}
+
+// Render s and check it against its golden, or write the golden
+static bool goldenScenario(const Scenario &s, bool update) {
+  RgbImage frame = renderScenario(s);
+  if (!update) return checkGolden(s.name, frame);
+  char path[256];
+  snprintf(path, sizeof(path), "%s/%s.png", goldenDir, s.name);
+  bool written = writePng(path, frame);
+  printf("  %-20s %s\n", s.name, written ? path : "FAIL: write failed");
+  return written;
+}
+
+static void usage() {
+  fprintf(stderr,
+          "usage: renderbench [--update] [--no-bench] [--seconds N] [--golden DIR] [--data DIR]\n"
+          "       renderbench --year YYYY [--days N]\n"
+          "  --update    write the goldens instead of checking them\n"
+          "  --no-bench  golden check only\n"
+          "  --seconds   virtual seconds of loop() timed per mode (default 60)\n"
+          "  --golden    golden PNG directory (default tools/renderbench/golden)\n"
+          "  --data      .vlw font directory (default data)\n"
+          "  --year      simulate a calendar year instead: zone sweep + year run\n"
+          "  --days      days of the year run (default 365)\n");
+}
+
+int main(int argc, char **argv) {
+  bool update = false;
+  bool bench = true;
+  int benchSeconds = 60;
+  int year = 0;
+  int days = 365;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--update") == 0) {
+      update = true;
+    } else if (strcmp(argv[i], "--no-bench") == 0) {
+      bench = false;
+    } else if (strcmp(argv[i], "--seconds") == 0 && i + 1 < argc) {
+      benchSeconds = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--golden") == 0 && i + 1 < argc) {
+      goldenDir = argv[++i];
+    } else if (strcmp(argv[i], "--data") == 0 && i + 1 < argc) {
+      shimDataDir = argv[++i];
+    } else if (strcmp(argv[i], "--year") == 0 && i + 1 < argc) {
+      year = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--days") == 0 && i + 1 < argc) {
+      days = atoi(argv[++i]);
+    } else {
+      usage();
+      return 2;
+    }
+  }
+
+  if (year > 0) {
+    struct tm jan1 = {};
+    jan1.tm_year = year - 1900;
+    jan1.tm_mday = 1;
+    time_t yearStart = timegm(&jan1);
+    jan1.tm_year++;
+    time_t yearEnd = timegm(&jan1);
+    if (days < 1 || days > (yearEnd - yearStart) / 86400) days = (int)((yearEnd - yearStart) / 86400);
+
+    shimSetWallTime(yearStart - 30);
+    setup();
+    bool sweepOk = runZoneSweep(yearStart, yearEnd);
+    bool yearOk = runYear(yearStart, days);
+    return (sweepOk && yearOk) ? 0 : 1;
+  }
+
+  shimSetWallTime(kFirstInstant - 30);
+  setup();
+  strlcpy(configuredHomeLabel, config.homeCityLabel, sizeof(configuredHomeLabel));
+
+  // Goldens first: the captures must not depend on --seconds
+  bool ok = true;
+  printf("%s goldens (%s):\n", update ? "Writing" : "Checking", goldenDir);
+  for (const Scenario &s : kScenarios) {
+    ok = goldenScenario(s, update) && ok;
+  }
+  for (const Scenario &s : kVariants) {
+    ok = goldenScenario(s, update) && ok;
+  }
+
+  if (bench) {
+    printf("\nFrames over %d s of virtual time per mode (host us):\n", benchSeconds);
+    printf("  %-20s %7s %10s %10s %11s %9s\n", "mode", "frames", "avg us", "max us", "px/frame",
+           "win/frame");
+    for (const Scenario &s : kScenarios) {
+      if (s.diagnostics) continue;
+      renderScenario(s);
+      FrameStats stats;
+      runUntil(wallUsNow() + (uint64_t)benchSeconds * 1000000, &stats);
+      printFrameStats(s.name, stats);
+    }
+
+    // First paint of a layer draws it and captures its cache, later ones
+    // restore it (a portrait screen flip is one alternate or portrait paint)
+    printf("\nFull static layout repaint (host us):\n");
+    printf("  %-27s %10s %11s %9s\n", "layer", "us", "pixels", "windows");
+    char name[64];
+    for (const Scenario &s : kScenarios) {
+      if (s.diagnostics) continue;
+      selectMode(s);
+      for (const char *paint : {"first", "cached"}) {
+        snprintf(name, sizeof(name), "%s %s", s.name, paint);
+        benchLayout(name, s.alternate ? drawAlternateLayout : drawStaticLayout);
+      }
+    }
+
+    printf("\nPortrait flip slide (%d fps):\n", SLIDE_FPS);
+    printf("  %-27s %7s %10s %10s %9s %8s\n", "to", "frames", "avg us", "max us", "ms", "scrolls");
+    for (const Scenario &s : kScenarios) {
+      if (!s.alternate) continue;
+      selectMode(s);
+      finishStaticLayout();
+      ok = benchSlide("alternate", LAYER_ALTERNATE) && ok;
+      ok = benchSlide("portrait", LAYER_MAIN) && ok;
+    }
+
+    printf("\nDiagnostics console, a log entry per second for %d s:\n", benchSeconds);
+    printf("  %-20s %7s %10s %10s %11s %9s\n", "mode", "frames", "avg us", "max us", "px/frame", "scrolls");
+    const Scenario consoles[] = {
+      {"portrait", 480, false, false, true, nullptr, false},
+      {"landscape", 540, true, false, true, nullptr, false},
+    };
+    for (const Scenario &s : consoles) {
+      ok = benchConsole(s.name, s, benchSeconds) && ok;
+    }
+    config.flipDisplay = true;  // Rotation 2: the scroll area runs bottom-up
+    ok = benchConsole("portrait flipped", consoles[0], benchSeconds) && ok;
+    config.flipDisplay = false;
+    selectMode(kScenarios[0]);
+  }
+
+  return ok ? 0 : 1;
+}
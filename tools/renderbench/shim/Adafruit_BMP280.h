@@ -0,0 +1,24 @@
+// BMP280 shim for renderbench: present when shimSensorPresent is set (the
+// default), reading a fixed 21.5 C / 1013.2 hPa so sensor screens render
+// the same every run.
+#ifndef RENDERBENCH_ADAFRUIT_BMP280_H
+#define RENDERBENCH_ADAFRUIT_BMP280_H
+
+#include <Arduino.h>
+
+extern bool shimSensorPresent;
+
+class Adafruit_BMP280 {
+ public:
+  enum sensor_mode { MODE_NORMAL = 3 };
+  enum sensor_sampling { SAMPLING_X2 = 2, SAMPLING_X16 = 5 };
+  enum sensor_filter { FILTER_X16 = 4 };
+  enum standby_duration { STANDBY_MS_500 = 4 };
+
+  bool begin(uint8_t = 0x77, uint8_t = 0x58) { return shimSensorPresent; }
+  void setSampling(sensor_mode, sensor_sampling, sensor_sampling, sensor_filter, standby_duration) {}
+  float readTemperature() { return 21.5f; }
+  float readPressure() { return 101320.0f; }
+};
+
+#endif // RENDERBENCH_ADAFRUIT_BMP280_H
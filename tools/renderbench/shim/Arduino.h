@@ -0,0 +1,169 @@
+// Arduino-ESP32 core shim for renderbench (host build of src/main.cpp).
+//
+// Only what main.cpp uses. Time is virtual and deterministic:
+//   - millis()/micros() advance only through delay(), task waits and
+//     shimAdvanceUs(), so the same run draws the same pixels
+//   - time()/gettimeofday() return the wall clock set by shimSetWallTime()
+//     (frozen between calls, plus whatever virtual time has passed since)
+// Pins read idle unless set with shimSetPin() (touch IRQ high = not
+// touched), the heap is a constant.
+#ifndef RENDERBENCH_ARDUINO_H
+#define RENDERBENCH_ARDUINO_H
+
+#include <math.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <time.h>
+
+#include <algorithm>
+#include <string>
+
+using std::max;
+using std::min;
+
+#define IRAM_ATTR
+#define HIGH 1
+#define LOW 0
+#define INPUT 0
+#define OUTPUT 1
+#define CHANGE 3
+#define ADC_11db 3
+#define VSPI 3
+#define HEX 16
+#define DEC 10
+
+// ---- Virtual clock ----
+uint64_t shimNowUs();                    // Virtual monotonic microseconds
+void shimAdvanceUs(uint64_t us);         // Let time pass (both clocks)
+void shimSetWallTime(time_t sec, uint32_t us = 0);
+time_t shimTime(time_t *out);
+int shimGettimeofday(struct timeval *tv, void *tz);
+
+// main.cpp reads the wall clock through these
+#define time(out) shimTime(out)
+#define gettimeofday(tv, tz) shimGettimeofday(tv, tz)
+
+inline unsigned long millis() { return (unsigned long)(shimNowUs() / 1000); }
+inline unsigned long micros() { return (unsigned long)shimNowUs(); }
+inline void delay(uint32_t ms) { shimAdvanceUs((uint64_t)ms * 1000); }
+inline void yield() {}
+
+template <typename T, typename L, typename H>
+inline T constrain(T v, L lo, H hi) { return v < lo ? (T)lo : (v > hi ? (T)hi : v); }
+
+size_t shimStrlcpy(char *dst, const char *src, size_t size);
+#define strlcpy shimStrlcpy
+
+// ---- Pins ----
+inline void pinMode(int, int) {}
+inline void digitalWrite(int, int) {}
+void shimSetPin(int pin, int level);  // Level digitalRead() returns
+int digitalRead(int pin);
+inline int analogRead(int) { return 1024; }
+inline void analogSetAttenuation(int) {}
+inline int digitalPinToInterrupt(int pin) { return pin; }
+inline void attachInterrupt(int, void (*)(), int) {}
+
+// ---- FreeRTOS (single task) ----
+typedef void *TaskHandle_t;
+typedef int BaseType_t;
+typedef uint32_t TickType_t;
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+#define portYIELD_FROM_ISR()
+inline TaskHandle_t xTaskGetCurrentTaskHandle() { return (TaskHandle_t)1; }
+inline void vTaskNotifyGiveFromISR(TaskHandle_t, BaseType_t *) {}
+uint32_t ulTaskNotifyTake(BaseType_t clear, TickType_t ticks);  // Sleeps the virtual clock
+void shimNotifyLoop();  // Pending notification: the next take returns at once
+
+// ---- String ----
+class String {
+ public:
+  String() {}
+  String(const char *s) : s_(s ? s : "") {}
+  String(const std::string &s) : s_(s) {}
+  String(char c) : s_(1, c) {}
+  String(int v, int base = DEC) : s_(fmt(v, base)) {}
+  String(unsigned v, int base = DEC) : s_(fmt(v, base)) {}
+  String(long v, int base = DEC) : s_(fmt(v, base)) {}
+  String(unsigned long v, int base = DEC) : s_(fmt(v, base)) {}
+  String(float v, int decimals = 2) : s_(fmtf(v, decimals)) {}
+  String(double v, int decimals = 2) : s_(fmtf(v, decimals)) {}
+
+  const char *c_str() const { return s_.c_str(); }
+  unsigned length() const { return (unsigned)s_.size(); }
+  String substring(unsigned from) const { return from < s_.size() ? String(s_.substr(from)) : String(); }
+  String substring(unsigned from, unsigned to) const {
+    if (from >= s_.size() || to <= from) return String();
+    return String(s_.substr(from, to - from));
+  }
+  long toInt() const { return atol(s_.c_str()); }
+  bool operator==(const String &o) const { return s_ == o.s_; }
+  bool operator==(const char *o) const { return s_ == (o ? o : ""); }
+  bool operator!=(const String &o) const { return s_ != o.s_; }
+  bool operator!=(const char *o) const { return !(*this == o); }
+  String &operator+=(const String &o) { s_ += o.s_; return *this; }
+  String &operator+=(const char *o) { s_ += o; return *this; }
+  String &operator+=(char c) { s_ += c; return *this; }
+  friend String operator+(const String &a, const String &b) { return String(a.s_ + b.s_); }
+  friend String operator+(const String &a, const char *b) { return String(a.s_ + b); }
+  friend String operator+(const char *a, const String &b) { return String(a + b.s_); }
+  const std::string &str() const { return s_; }
+
+ private:
+  static std::string fmt(long long v, int base) {
+    char buf[32];
+    snprintf(buf, sizeof(buf), base == HEX ? "%llx" : "%lld", v);
+    return buf;
+  }
+  static std::string fmtf(double v, int decimals) {
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%.*f", decimals, v);
+    return buf;
+  }
+  std::string s_;
+};
+
+// ---- Serial (stdout when RENDERBENCH_SERIAL is set, else discarded) ----
+class HardwareSerial {
+ public:
+  void begin(unsigned long) {}
+  size_t print(const char *s) { return out("%s", s); }
+  size_t print(const String &s) { return out("%s", s.c_str()); }
+  size_t print(char c) { return out("%c", c); }
+  size_t print(int v) { return out("%d", v); }
+  size_t print(unsigned v) { return out("%u", v); }
+  size_t print(long v) { return out("%ld", v); }
+  size_t print(unsigned long v) { return out("%lu", v); }
+  size_t print(double v, int d = 2) { return out("%.*f", d, v); }
+  size_t println() { return out("\n"); }
+  template <typename T> size_t println(const T &v) { return print(v) + println(); }
+  size_t printf(const char *format, ...) __attribute__((format(printf, 2, 3)));
+  size_t write(uint8_t b) { return out("%c", b); }
+  size_t write(const uint8_t *buf, size_t len);
+  void flush() {}
+
+ private:
+  size_t out(const char *format, ...) __attribute__((format(printf, 2, 3)));
+};
+extern HardwareSerial Serial;
+
+// ---- ESP ----
+class EspClass {
+ public:
+  uint32_t getFreeHeap() { return 180000; }
+  void restart() { exit(0); }
+};
+extern EspClass ESP;
+
+// Arduino-ESP32 time helpers (configTzTime sets TZ for localtime_r)
+void configTzTime(const char *tz, const char *server1, const char *server2 = nullptr,
+                  const char *server3 = nullptr);
+bool getLocalTime(struct tm *info, uint32_t ms = 5000);
+
+#endif // RENDERBENCH_ARDUINO_H
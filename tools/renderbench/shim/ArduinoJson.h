@@ -0,0 +1,46 @@
+// ArduinoJson shim for renderbench: documents hold nothing. The API
+// handlers compile (renderbench never calls them); reads are null.
+#ifndef RENDERBENCH_ARDUINOJSON_H
+#define RENDERBENCH_ARDUINOJSON_H
+
+#include <Arduino.h>
+
+class JsonVariant {
+ public:
+  template <typename K> JsonVariant operator[](K) const { return JsonVariant(); }
+  template <typename T> JsonVariant &operator=(const T &) { return *this; }
+  template <typename T> T to() const { return T(); }
+  template <typename T> T as() const { return T(); }
+  template <typename T> bool is() const { return false; }
+  template <typename T> T add() const { return T(); }
+  template <typename T> bool add(const T &) const { return false; }
+  template <typename T> operator T() const { return T(); }
+  bool isNull() const { return true; }
+  const JsonVariant *begin() const { return nullptr; }
+  const JsonVariant *end() const { return nullptr; }
+};
+
+class JsonObject : public JsonVariant {};
+class JsonArray : public JsonVariant {};
+class JsonDocument : public JsonVariant {};
+
+template <typename T> T serialized(const T &raw) {
+  return raw;
+}
+
+class DeserializationError {
+ public:
+  explicit operator bool() const { return true; }
+  const char *c_str() const { return "NoJson"; }
+};
+
+template <typename T> DeserializationError deserializeJson(JsonDocument &, const T &) {
+  return DeserializationError();
+}
+
+inline size_t serializeJson(const JsonVariant &, String &out) {
+  out = "{}";
+  return 2;
+}
+
+#endif // RENDERBENCH_ARDUINOJSON_H
@@ -0,0 +1,34 @@
+// LittleFS shim for renderbench: no filesystem (begin() fails), so fonts
+// come from the compiled arrays and the tzdb stays closed.
+#ifndef RENDERBENCH_LITTLEFS_H
+#define RENDERBENCH_LITTLEFS_H
+
+#include <Arduino.h>
+
+class File {
+ public:
+  explicit operator bool() const { return false; }
+  bool isDirectory() const { return false; }
+  File openNextFile() { return File(); }
+  const char *name() const { return ""; }
+  size_t size() const { return 0; }
+  int read() { return -1; }
+  size_t read(uint8_t *, size_t) { return 0; }
+  bool seek(uint32_t) { return false; }
+  size_t position() const { return 0; }
+  int available() { return 0; }
+  void close() {}
+};
+
+namespace fs {
+class FS {
+ public:
+  bool begin(bool = false) { return false; }
+  bool exists(const char *) { return false; }
+  File open(const char *, const char * = "r") { return File(); }
+};
+}  // namespace fs
+
+extern fs::FS LittleFS;
+
+#endif // RENDERBENCH_LITTLEFS_H
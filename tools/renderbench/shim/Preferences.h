@@ -0,0 +1,23 @@
+// Preferences (NVS) shim for renderbench: nothing stored, every get returns
+// its default, so loadConfig() yields the firmware defaults.
+#ifndef RENDERBENCH_PREFERENCES_H
+#define RENDERBENCH_PREFERENCES_H
+
+#include <Arduino.h>
+
+class Preferences {
+ public:
+  bool begin(const char *, bool = false) { return true; }
+  void end() {}
+  bool isKey(const char *) { return false; }
+  bool remove(const char *) { return false; }
+  String getString(const char *, const String &def = String()) { return def; }
+  bool getBool(const char *, bool def = false) { return def; }
+  uint8_t getUChar(const char *, uint8_t def = 0) { return def; }
+  size_t putString(const char *, const String &) { return 0; }
+  size_t putString(const char *, const char *) { return 0; }
+  size_t putBool(const char *, bool) { return 0; }
+  size_t putUChar(const char *, uint8_t) { return 0; }
+};
+
+#endif // RENDERBENCH_PREFERENCES_H
@@ -0,0 +1,13 @@
+// SPI shim for renderbench.
+#ifndef RENDERBENCH_SPI_H
+#define RENDERBENCH_SPI_H
+
+#include <Arduino.h>
+
+class SPIClass {
+ public:
+  explicit SPIClass(int = 0) {}
+  void begin(int = -1, int = -1, int = -1, int = -1) {}
+};
+
+#endif // RENDERBENCH_SPI_H
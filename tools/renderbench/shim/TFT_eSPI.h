@@ -0,0 +1,244 @@
+// TFT_eSPI shim for renderbench: the panel and every sprite draw into an
+// in-memory RGB565 framebuffer.
+//
+// Covers the API main.cpp uses. Primitives follow TFT_eSPI's algorithms
+// (Bresenham lines, Adafruit triangles/circles, smooth font glyph blending);
+// the anti-aliased primitives use a signed-distance coverage. Smooth fonts
+// load from the compiled arrays or from .vlw files in shimDataDir. The
+// bitmap fonts 1/2/4 (built into the real library) are stood in for by the
+// bundled .vlw fonts placed in the same line heights; glyph widths differ,
+// so text drawn with them is approximate (still deterministic).
+//
+// The panel counts the pixels written to it and the windows (primitive
+// calls / sprite pushes) that carried them, for renderbench's per-frame
+// figures. It stands for an ILI9341: writecommand()/writedata() decode the
+// vertical scroll area (VSCRDEF) and start (VSCRSADD) into scrollTop,
+// scrollLines and scrollStart; the framebuffer stays in memory order.
+#ifndef RENDERBENCH_TFT_ESPI_H
+#define RENDERBENCH_TFT_ESPI_H
+
+#define ILI9341_DRIVER
+
+#include <Arduino.h>
+
+#include <vector>
+
+#ifndef TFT_WIDTH
+#define TFT_WIDTH 240
+#endif
+#ifndef TFT_HEIGHT
+#define TFT_HEIGHT 320
+#endif
+
+#define TFT_BLACK       0x0000
+#define TFT_NAVY        0x000F
+#define TFT_DARKGREEN   0x03E0
+#define TFT_DARKCYAN    0x03EF
+#define TFT_MAROON      0x7800
+#define TFT_PURPLE      0x780F
+#define TFT_OLIVE       0x7BE0
+#define TFT_LIGHTGREY   0xD69A
+#define TFT_DARKGREY    0x7BEF
+#define TFT_BLUE        0x001F
+#define TFT_GREEN       0x07E0
+#define TFT_CYAN        0x07FF
+#define TFT_RED         0xF800
+#define TFT_MAGENTA     0xF81F
+#define TFT_YELLOW      0xFFE0
+#define TFT_WHITE       0xFFFF
+#define TFT_ORANGE      0xFDA0
+#define TFT_GREENYELLOW 0xB7E0
+#define TFT_PINK        0xFE19
+#define TFT_BROWN       0x9A60
+#define TFT_GOLD        0xFEA0
+#define TFT_SILVER      0xC618
+#define TFT_SKYBLUE     0x867D
+#define TFT_VIOLET      0x915C
+
+#define TL_DATUM 0
+#define TC_DATUM 1
+#define TR_DATUM 2
+#define ML_DATUM 3
+#define CL_DATUM 3
+#define MC_DATUM 4
+#define CC_DATUM 4
+#define MR_DATUM 5
+#define CR_DATUM 5
+#define BL_DATUM 6
+#define BC_DATUM 7
+#define BR_DATUM 8
+#define L_BASELINE 9
+#define C_BASELINE 10
+#define R_BASELINE 11
+
+#define SHIM_NO_BG 0x00FFFFFF  // "Blend with what is already there"
+
+namespace fs {
+class FS;
+}
+
+extern const char *shimDataDir;  // .vlw files for loadFont(name, fs) and bitmap stand-ins
+
+// Parsed .vlw font (TFT_eSPI Smooth_font.cpp layout)
+struct ShimFont {
+  std::vector<uint8_t> file;  // Owned copy when loaded from disk
+  const uint8_t *data = nullptr;
+  uint32_t gCount = 0;
+  int32_t yAdvance = 0, ascent = 0, descent = 0, maxAscent = 0, maxDescent = 0, spaceWidth = 0;
+  std::vector<uint32_t> unicode, bitmap;
+  std::vector<uint8_t> height, width, xAdvance;
+  std::vector<int16_t> dY, dX;
+
+  bool parse(const uint8_t *bytes);
+  int find(uint16_t code) const;
+};
+
+class TFT_eSPI {
+ public:
+  TFT_eSPI(int16_t w = TFT_WIDTH, int16_t h = TFT_HEIGHT);
+  virtual ~TFT_eSPI();
+
+  void init(uint8_t tc = 0);
+  void begin(uint8_t tc = 0) { init(tc); }
+  void setRotation(uint8_t r);
+  uint8_t getRotation() const { return rotation_; }
+  int16_t width() const { return vpDatum_ ? vpW_ : width_; }
+  int16_t height() const { return vpDatum_ ? vpH_ : height_; }
+
+  void drawPixel(int32_t x, int32_t y, uint32_t color);
+  uint16_t readPixel(int32_t x, int32_t y);
+  void fillScreen(uint32_t color);
+  void fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color);
+  void drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color);
+  void drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color);
+  void drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color);
+  void drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t color);
+  void drawCircle(int32_t x0, int32_t y0, int32_t r, uint32_t color);
+  void fillCircle(int32_t x0, int32_t y0, int32_t r, uint32_t color);
+  void fillTriangle(int32_t x0, int32_t y0, int32_t x1, int32_t y1, int32_t x2, int32_t y2, uint32_t color);
+  void drawSmoothCircle(int32_t x, int32_t y, int32_t r, uint32_t fg, uint32_t bg);
+  void fillSmoothCircle(int32_t x, int32_t y, int32_t r, uint32_t color, uint32_t bg = SHIM_NO_BG);
+  void drawWideLine(float ax, float ay, float bx, float by, float wd, uint32_t fg, uint32_t bg = SHIM_NO_BG);
+  void drawWedgeLine(float ax, float ay, float bx, float by, float aw, float bw, uint32_t fg,
+                     uint32_t bg = SHIM_NO_BG);
+  void pushImage(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t *data);
+  // Raw window (no viewport): pushColor() fills it row by row
+  void setAddrWindow(int32_t x, int32_t y, int32_t w, int32_t h);
+  void pushColor(uint16_t color, uint32_t len = 1);
+
+  // Text
+  void setTextColor(uint16_t fg) { textFg_ = textBg_ = fg; }
+  void setTextColor(uint16_t fg, uint16_t bg, bool fill = false) {
+    textFg_ = fg;
+    textBg_ = bg;
+    fillBg_ = fill;
+  }
+  void setTextDatum(uint8_t d) { datum_ = d; }
+  void setTextPadding(uint16_t px) { padding_ = px; }
+  void setTextFont(uint8_t f);
+  void setTextSize(uint8_t s) { textSize_ = s ? s : 1; }
+  void setTextWrap(bool, bool = false) {}
+  int16_t drawString(const char *s, int32_t x, int32_t y);
+  int16_t drawString(const String &s, int32_t x, int32_t y) { return drawString(s.c_str(), x, y); }
+  int16_t textWidth(const char *s);
+  int16_t textWidth(const String &s) { return textWidth(s.c_str()); }
+  int16_t fontHeight();
+  void loadFont(const uint8_t *array);
+  void loadFont(String name, fs::FS &fs);
+  void unloadFont();
+
+  // Clip (and with vpDatum, move the origin) to a rectangle
+  void setViewport(int32_t x, int32_t y, int32_t w, int32_t h, bool vpDatum = true);
+  void resetViewport();
+
+  // Bus/DMA: no DMA on the host (bands take the pushSprite path)
+  bool initDMA(bool = false) { return false; }
+  void pushImageDMA(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t *data) { pushImage(x, y, w, h, data); }
+  void dmaWait() {}
+  void startWrite() {}
+  void endWrite() {}
+
+  // Panel commands (only VSCRDEF and VSCRSADD are interpreted)
+  void writecommand(uint8_t c);
+  void writedata(uint8_t d);
+
+  static uint16_t alphaBlend(uint8_t alpha, uint16_t fg, uint16_t bg);
+
+  // Panel framebuffer (logical orientation) and write counters
+  const std::vector<uint16_t> &framebuffer() const { return fb_; }
+  uint64_t pixelsWritten = 0;
+  uint64_t windows = 0;
+  uint16_t scrollTop = 0;             // Fixed lines above the scroll area
+  uint16_t scrollLines = TFT_HEIGHT;  // Lines in the scroll area
+  uint16_t scrollStart = 0;           // Memory line at the top of the area
+  uint32_t scrollSets = 0;   // VSCRSADD commands
+
+ protected:
+  friend class TFT_eSprite;
+  virtual void storePixel(int32_t x, int32_t y, uint16_t color);  // After clipping
+  virtual uint16_t loadPixel(int32_t x, int32_t y);
+  // Row runs after clipping: n pixels of one colour, or copied from src
+  virtual void storeRun(int32_t x, int32_t y, int32_t n, uint16_t color);
+  virtual void storeRun(int32_t x, int32_t y, int32_t n, const uint16_t *src);
+  void plot(int32_t x, int32_t y, uint16_t color);  // Viewport-relative, clipped
+  void plotAlpha(int32_t x, int32_t y, float alpha, uint16_t fg, uint32_t bg);
+  void drawGlyph(uint16_t code, int32_t &cursorX, int32_t cursorY);
+  const ShimFont *activeFont() const;
+
+  int16_t width_, height_;
+  uint8_t rotation_ = 0;
+  std::vector<uint16_t> fb_;
+
+  // Viewport: clip rect in buffer coordinates, origin offset when vpDatum
+  int32_t vpX_ = 0, vpY_ = 0, vpW_ = 0, vpH_ = 0;
+  int32_t clipX0_ = 0, clipY0_ = 0, clipX1_ = 0, clipY1_ = 0;
+  bool vpDatum_ = false;
+
+  uint16_t textFg_ = TFT_WHITE, textBg_ = TFT_WHITE;
+  bool fillBg_ = false;
+  uint8_t datum_ = TL_DATUM;
+  uint16_t padding_ = 0;
+  uint8_t textFont_ = 1, textSize_ = 1;
+  ShimFont *smooth_ = nullptr;  // Loaded smooth font, if any
+  int32_t winX0_ = 0, winX1_ = 0, winY1_ = 0;  // setAddrWindow() columns, end row
+  int32_t winX_ = 0, winY_ = 0;                // Next pixel pushColor() writes
+  uint8_t command_ = 0;         // Last command and the data bytes after it
+  uint16_t commandData_ = 0;
+  uint8_t commandBytes_ = 0;
+};
+
+class TFT_eSprite : public TFT_eSPI {
+ public:
+  explicit TFT_eSprite(TFT_eSPI *parent);
+  TFT_eSprite(const TFT_eSprite &other);
+  ~TFT_eSprite() override;
+
+  void setColorDepth(int8_t bits) { depth_ = bits; }
+  void *createSprite(int16_t w, int16_t h, uint8_t frames = 1);
+  void deleteSprite();
+  bool created() const { return created_; }
+  void *getPointer() { return created_ ? (depth_ == 1 ? (void *)bits_.data() : (void *)fb_.data()) : nullptr; }
+  void setBitmapColor(uint16_t fg, uint16_t bg) {
+    bitmapFg_ = fg;
+    bitmapBg_ = bg;
+  }
+  void fillSprite(uint32_t color) { fillScreen(color); }
+  void pushSprite(int32_t x, int32_t y);
+  void pushSprite(int32_t x, int32_t y, uint16_t transparent);
+  bool pushSprite(int32_t tx, int32_t ty, int32_t sx, int32_t sy, int32_t sw, int32_t sh);
+
+ protected:
+  void storePixel(int32_t x, int32_t y, uint16_t color) override;
+  uint16_t loadPixel(int32_t x, int32_t y) override;
+  void storeRun(int32_t x, int32_t y, int32_t n, uint16_t color) override;
+  void storeRun(int32_t x, int32_t y, int32_t n, const uint16_t *src) override;
+
+ private:
+  TFT_eSPI *parent_;
+  int8_t depth_ = 16;
+  bool created_ = false;
+  std::vector<uint8_t> bits_;  // 1 bpp rows, byte aligned
+  uint16_t bitmapFg_ = 1, bitmapBg_ = 0;
+};
+
+#endif // RENDERBENCH_TFT_ESPI_H
@@ -0,0 +1,35 @@
+// WebServer shim for renderbench: routes are accepted and never called.
+#ifndef RENDERBENCH_WEBSERVER_H
+#define RENDERBENCH_WEBSERVER_H
+
+#include <Arduino.h>
+#include <LittleFS.h>
+#include <WiFi.h>
+
+#include <functional>
+
+#define HTTP_GET 1
+#define HTTP_POST 3
+#define CONTENT_LENGTH_UNKNOWN ((size_t)-1)
+
+class WebServer {
+ public:
+  explicit WebServer(int = 80) {}
+  typedef std::function<void()> Handler;
+  void on(const char *, Handler) {}
+  void on(const char *, int, Handler) {}
+  void serveStatic(const char *, fs::FS &, const char *, const char * = nullptr) {}
+  void begin() {}
+  void handleClient() {}
+  String arg(const char *) { return String(); }
+  bool hasArg(const char *) { return false; }
+  void send(int, const char * = nullptr, const char * = nullptr) {}
+  void send(int code, const char *type, const String &body) { send(code, type, body.c_str()); }
+  void sendContent(const char *, size_t = 0) {}
+  void sendContent(const String &) {}
+  void setContentLength(size_t) {}
+  size_t streamFile(File &, const char *) { return 0; }
+  WiFiClient client() { return WiFiClient(); }
+};
+
+#endif // RENDERBENCH_WEBSERVER_H
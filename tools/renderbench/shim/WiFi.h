@@ -0,0 +1,36 @@
+// WiFi shim for renderbench: never connected.
+#ifndef RENDERBENCH_WIFI_H
+#define RENDERBENCH_WIFI_H
+
+#include <Arduino.h>
+
+#define WIFI_STA 1
+#define WIFI_AP 2
+
+class IPAddress {
+ public:
+  String toString() const { return String("0.0.0.0"); }
+};
+
+class WiFiClient {
+ public:
+  operator bool() const { return false; }  // Connected
+  size_t write(const char *s) { return strlen(s); }
+  size_t write(const uint8_t *, size_t len) { return len; }
+  size_t printf(const char *, ...) { return 0; }
+};
+
+class WiFiClass {
+ public:
+  bool mode(int) { return true; }
+  bool softAP(const char *) { return true; }
+  IPAddress softAPIP() { return IPAddress(); }
+  IPAddress localIP() { return IPAddress(); }
+  bool isConnected() { return false; }
+  String SSID() { return String(); }
+  int RSSI() { return 0; }
+};
+
+extern WiFiClass WiFi;
+
+#endif // RENDERBENCH_WIFI_H
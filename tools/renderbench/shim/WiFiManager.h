@@ -0,0 +1,23 @@
+// WiFiManager shim for renderbench: autoConnect() fails at once, so setup()
+// takes the fallback-AP path without waiting on a network.
+#ifndef RENDERBENCH_WIFIMANAGER_H
+#define RENDERBENCH_WIFIMANAGER_H
+
+#include <WebServer.h>
+
+#include <memory>
+
+class WiFiManager {
+ public:
+  WiFiManager() : server(new WebServer(80)) {}
+  std::unique_ptr<WebServer> server;
+  void setConfigPortalTimeout(unsigned long) {}
+  void setConnectTimeout(unsigned long) {}
+  void setAPCallback(std::function<void(WiFiManager *)>) {}
+  void setWebServerCallback(std::function<void()>) {}
+  bool autoConnect(const char *) { return false; }
+  void resetSettings() {}
+  String getConfigPortalSSID() { return String(); }
+};
+
+#endif // RENDERBENCH_WIFIMANAGER_H
@@ -0,0 +1,14 @@
+// Wire (I2C) shim for renderbench.
+#ifndef RENDERBENCH_WIRE_H
+#define RENDERBENCH_WIRE_H
+
+#include <Arduino.h>
+
+class TwoWire {
+ public:
+  bool begin(int = -1, int = -1) { return true; }
+};
+
+extern TwoWire Wire;
+
+#endif // RENDERBENCH_WIRE_H
@@ -0,0 +1,15 @@
+// XPT2046 shim for renderbench: main.cpp only reads the IRQ pin (see
+// shimSetPin()).
+#ifndef RENDERBENCH_XPT2046_TOUCHSCREEN_H
+#define RENDERBENCH_XPT2046_TOUCHSCREEN_H
+
+#include <SPI.h>
+
+class XPT2046_Touchscreen {
+ public:
+  XPT2046_Touchscreen(uint8_t, uint8_t = 255) {}
+  bool begin(SPIClass &) { return true; }
+  void setRotation(uint8_t) {}
+};
+
+#endif // RENDERBENCH_XPT2046_TOUCHSCREEN_H
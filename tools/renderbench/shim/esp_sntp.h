@@ -0,0 +1,10 @@
+// esp_sntp shim for renderbench: the sync callback fires from configTzTime().
+#ifndef RENDERBENCH_ESP_SNTP_H
+#define RENDERBENCH_ESP_SNTP_H
+
+#include <sys/time.h>
+
+typedef void (*sntp_sync_time_cb_t)(struct timeval *tv);
+void sntp_set_time_sync_notification_cb(sntp_sync_time_cb_t callback);
+
+#endif // RENDERBENCH_ESP_SNTP_H
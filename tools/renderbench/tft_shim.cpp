@@ -0,0 +1,759 @@
+// TFT_eSPI framebuffer shim (see shim/TFT_eSPI.h).
+#include <TFT_eSPI.h>
+
+#include <math.h>
+#include <stdio.h>
+
+#include <algorithm>
+#include <utility>
+
+const char *shimDataDir = "data";
+
+// =========================
+// Smooth fonts (.vlw)
+// =========================
+
+static uint32_t readBe32(const uint8_t *p) {
+  return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+// Same metrics as TFT_eSPI loadMetrics(): max ascent/descent over the
+// printable glyphs, yAdvance = maxAscent + maxDescent
+bool ShimFont::parse(const uint8_t *bytes) {
+  data = bytes;
+  gCount = readBe32(bytes);
+  yAdvance = (int32_t)readBe32(bytes + 8);
+  ascent = (int32_t)readBe32(bytes + 16);
+  descent = (int32_t)readBe32(bytes + 20);
+  if (gCount == 0 || gCount > 0xFFFF) return false;
+
+  unicode.resize(gCount);
+  bitmap.resize(gCount);
+  height.resize(gCount);
+  width.resize(gCount);
+  xAdvance.resize(gCount);
+  dY.resize(gCount);
+  dX.resize(gCount);
+
+  const uint8_t *meta = bytes + 24;
+  uint32_t bitmapOffset = 24 + gCount * 28;
+  maxAscent = ascent;
+  maxDescent = descent;
+  for (uint32_t g = 0; g < gCount; g++, meta += 28) {
+    unicode[g] = readBe32(meta);
+    height[g] = (uint8_t)readBe32(meta + 4);
+    width[g] = (uint8_t)readBe32(meta + 8);
+    xAdvance[g] = (uint8_t)readBe32(meta + 12);
+    dY[g] = (int16_t)readBe32(meta + 16);
+    dX[g] = (int8_t)readBe32(meta + 20);
+    bitmap[g] = bitmapOffset;
+    bitmapOffset += (uint32_t)width[g] * height[g];
+
+    uint32_t u = unicode[g];
+    bool printable = (u > 0x20 && u < 0xA0 && u != 0x7F) || u > 0xFF;
+    if (printable && (int32_t)height[g] - dY[g] > maxDescent) maxDescent = height[g] - dY[g];
+    if (printable && dY[g] > maxAscent) maxAscent = dY[g];
+  }
+  yAdvance = maxAscent + maxDescent;
+  spaceWidth = (ascent + descent) * 2 / 7;
+  return true;
+}
+
+int ShimFont::find(uint16_t code) const {
+  for (uint32_t g = 0; g < gCount; g++) {
+    if (unicode[g] == code) return (int)g;
+  }
+  return -1;
+}
+
+static bool readFile(const char *path, std::vector<uint8_t> *out) {
+  FILE *f = fopen(path, "rb");
+  if (!f) return false;
+  fseek(f, 0, SEEK_END);
+  long size = ftell(f);
+  fseek(f, 0, SEEK_SET);
+  out->resize(size > 0 ? (size_t)size : 0);
+  bool ok = size > 0 && fread(out->data(), 1, out->size(), f) == out->size();
+  fclose(f);
+  return ok;
+}
+
+// Stand-ins for the bitmap fonts 1/2/4 (8, 16 and 26 px lines)
+struct BitmapStandIn {
+  uint8_t font;
+  const char *vlw;
+  int16_t lineHeight;
+};
+
+static const BitmapStandIn kBitmapStandIns[] = {
+  {1, "NotoSans-Bold7", 8},
+  {2, "NotoSans-Bold10", 16},
+  {4, "NotoSans-Bold16", 26},
+};
+
+static const BitmapStandIn &standIn(uint8_t font) {
+  for (const BitmapStandIn &s : kBitmapStandIns) {
+    if (s.font == font) return s;
+  }
+  return kBitmapStandIns[0];
+}
+
+static ShimFont *standInFont(uint8_t font) {
+  static ShimFont fonts[3];
+  static bool tried[3];
+  int i = (font == 4) ? 2 : (font == 2) ? 1 : 0;
+  if (!tried[i]) {
+    tried[i] = true;
+    char path[256];
+    snprintf(path, sizeof(path), "%s/%s.vlw", shimDataDir, standIn(font).vlw);
+    if (!readFile(path, &fonts[i].file) || !fonts[i].parse(fonts[i].file.data())) {
+      fprintf(stderr, "renderbench: missing bitmap font stand-in %s\n", path);
+      fonts[i] = ShimFont();
+    }
+  }
+  return fonts[i].data ? &fonts[i] : nullptr;
+}
+
+// =========================
+// TFT_eSPI
+// =========================
+
+TFT_eSPI::TFT_eSPI(int16_t w, int16_t h) : width_(w), height_(h) {
+  resetViewport();
+}
+
+TFT_eSPI::~TFT_eSPI() {
+  delete smooth_;
+}
+
+void TFT_eSPI::init(uint8_t) {
+  fb_.assign((size_t)width_ * height_, TFT_BLACK);
+  resetViewport();
+}
+
+void TFT_eSPI::setRotation(uint8_t r) {
+  rotation_ = r & 3;
+  int16_t shortSide = min(width_, height_);
+  int16_t longSide = max(width_, height_);
+  bool landscape = rotation_ & 1;
+  int16_t w = landscape ? longSide : shortSide;
+  int16_t h = landscape ? shortSide : longSide;
+  if (w != width_ || fb_.size() != (size_t)w * h) {
+    width_ = w;
+    height_ = h;
+    fb_.assign((size_t)w * h, TFT_BLACK);
+  }
+  resetViewport();
+}
+
+void TFT_eSPI::writecommand(uint8_t c) {
+  command_ = c;
+  commandData_ = 0;
+  commandBytes_ = 0;
+}
+
+void TFT_eSPI::writedata(uint8_t d) {
+  commandData_ = (uint16_t)(commandData_ << 8 | d);
+  commandBytes_++;
+  if (command_ == 0x33 && commandBytes_ == 2) {  // VSCRDEF: top fixed lines
+    scrollTop = commandData_;
+  } else if (command_ == 0x33 && commandBytes_ == 4) {  // Scroll area lines
+    scrollLines = commandData_;
+  } else if (command_ == 0x37 && commandBytes_ == 2) {  // VSCRSADD
+    scrollStart = commandData_;
+    scrollSets++;
+  }
+}
+
+void TFT_eSPI::setViewport(int32_t x, int32_t y, int32_t w, int32_t h, bool vpDatum) {
+  vpX_ = x;
+  vpY_ = y;
+  vpW_ = w;
+  vpH_ = h;
+  vpDatum_ = vpDatum;
+  clipX0_ = max<int32_t>(x, 0);
+  clipY0_ = max<int32_t>(y, 0);
+  clipX1_ = min<int32_t>(x + w, width_);
+  clipY1_ = min<int32_t>(y + h, height_);
+}
+
+void TFT_eSPI::resetViewport() {
+  vpX_ = vpY_ = 0;
+  vpW_ = width_;
+  vpH_ = height_;
+  vpDatum_ = false;
+  clipX0_ = clipY0_ = 0;
+  clipX1_ = width_;
+  clipY1_ = height_;
+}
+
+void TFT_eSPI::storePixel(int32_t x, int32_t y, uint16_t color) {
+  fb_[(size_t)y * width_ + x] = color;
+  pixelsWritten++;
+}
+
+uint16_t TFT_eSPI::loadPixel(int32_t x, int32_t y) {
+  return fb_[(size_t)y * width_ + x];
+}
+
+void TFT_eSPI::storeRun(int32_t x, int32_t y, int32_t n, uint16_t color) {
+  std::fill_n(fb_.begin() + (size_t)y * width_ + x, n, color);
+  pixelsWritten += n;
+}
+
+void TFT_eSPI::storeRun(int32_t x, int32_t y, int32_t n, const uint16_t *src) {
+  std::copy_n(src, n, fb_.begin() + (size_t)y * width_ + x);
+  pixelsWritten += n;
+}
+
+void TFT_eSPI::plot(int32_t x, int32_t y, uint16_t color) {
+  if (vpDatum_) {
+    x += vpX_;
+    y += vpY_;
+  }
+  if (x < clipX0_ || y < clipY0_ || x >= clipX1_ || y >= clipY1_) return;
+  storePixel(x, y, color);
+}
+
+uint16_t TFT_eSPI::alphaBlend(uint8_t alpha, uint16_t fgc, uint16_t bgc) {
+  uint32_t rxb = bgc & 0xF81F;
+  rxb += ((fgc & 0xF81F) - rxb) * (alpha >> 2) >> 6;
+  uint32_t xgx = bgc & 0x07E0;
+  xgx += ((fgc & 0x07E0) - xgx) * alpha >> 8;
+  return (rxb & 0xF81F) | (xgx & 0x07E0);
+}
+
+void TFT_eSPI::plotAlpha(int32_t x, int32_t y, float alpha, uint16_t fg, uint32_t bg) {
+  if (alpha <= 0.0f) return;
+  uint8_t a = alpha >= 1.0f ? 255 : (uint8_t)(alpha * 255.0f + 0.5f);
+  if (a == 255) {
+    plot(x, y, fg);
+    return;
+  }
+  uint16_t under = (uint16_t)bg;
+  if (bg == SHIM_NO_BG) {
+    under = readPixel(x, y);
+  }
+  plot(x, y, alphaBlend(a, fg, under));
+}
+
+void TFT_eSPI::drawPixel(int32_t x, int32_t y, uint32_t color) {
+  windows++;
+  plot(x, y, (uint16_t)color);
+}
+
+void TFT_eSPI::setAddrWindow(int32_t x, int32_t y, int32_t w, int32_t h) {
+  windows++;
+  winX0_ = winX_ = x;
+  winX1_ = x + w;
+  winY_ = y;
+  winY1_ = y + h;
+}
+
+void TFT_eSPI::pushColor(uint16_t color, uint32_t len) {
+  while (len > 0 && winY_ < winY1_) {
+    int32_t n = min<int32_t>((int32_t)min<uint32_t>(len, INT32_MAX), winX1_ - winX_);
+    int32_t x0 = max<int32_t>(winX_, 0), x1 = min<int32_t>(winX_ + n, width_);
+    if (winY_ >= 0 && winY_ < height_ && x0 < x1) storeRun(x0, winY_, x1 - x0, color);
+    len -= n;
+    winX_ += n;
+    if (winX_ == winX1_) {
+      winX_ = winX0_;
+      winY_++;
+    }
+  }
+}
+
+uint16_t TFT_eSPI::readPixel(int32_t x, int32_t y) {
+  if (vpDatum_) {
+    x += vpX_;
+    y += vpY_;
+  }
+  if (x < 0 || y < 0 || x >= width_ || y >= height_) return 0;
+  return loadPixel(x, y);
+}
+
+void TFT_eSPI::fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) {
+  windows++;
+  if (vpDatum_) {
+    x += vpX_;
+    y += vpY_;
+  }
+  int32_t x0 = max(x, clipX0_), x1 = min(x + w, clipX1_);
+  int32_t y0 = max(y, clipY0_), y1 = min(y + h, clipY1_);
+  for (int32_t j = y0; j < y1 && x0 < x1; j++) {
+    storeRun(x0, j, x1 - x0, (uint16_t)color);
+  }
+}
+
+void TFT_eSPI::fillScreen(uint32_t color) {
+  // Whole buffer regardless of the viewport origin (as TFT_eSPI)
+  bool datum = vpDatum_;
+  vpDatum_ = false;
+  fillRect(0, 0, width_, height_, color);
+  vpDatum_ = datum;
+}
+
+void TFT_eSPI::drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) {
+  drawFastHLine(x, y, w, color);
+  drawFastHLine(x, y + h - 1, w, color);
+  drawFastVLine(x, y + 1, h - 2, color);
+  drawFastVLine(x + w - 1, y + 1, h - 2, color);
+}
+
+void TFT_eSPI::drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color) {
+  fillRect(x, y, w, 1, color);
+}
+
+void TFT_eSPI::drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color) {
+  fillRect(x, y, 1, h, color);
+}
+
+// Bresenham, as TFT_eSPI::drawLine (error starts at dx / 2)
+void TFT_eSPI::drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t color) {
+  windows++;
+  bool steep = abs(y1 - y0) > abs(x1 - x0);
+  if (steep) {
+    std::swap(x0, y0);
+    std::swap(x1, y1);
+  }
+  if (x0 > x1) {
+    std::swap(x0, x1);
+    std::swap(y0, y1);
+  }
+  int32_t dx = x1 - x0;
+  int32_t dy = abs(y1 - y0);
+  int32_t err = dx >> 1;
+  int32_t ystep = (y0 < y1) ? 1 : -1;
+  for (; x0 <= x1; x0++) {
+    if (steep) {
+      plot(y0, x0, (uint16_t)color);
+    } else {
+      plot(x0, y0, (uint16_t)color);
+    }
+    err -= dy;
+    if (err < 0) {
+      y0 += ystep;
+      err += dx;
+    }
+  }
+}
+
+void TFT_eSPI::drawCircle(int32_t x0, int32_t y0, int32_t r, uint32_t color) {
+  windows++;
+  int32_t f = 1 - r;
+  int32_t ddFx = 1;
+  int32_t ddFy = -2 * r;
+  int32_t x = 0;
+  int32_t y = r;
+  uint16_t c = (uint16_t)color;
+  plot(x0, y0 + r, c);
+  plot(x0, y0 - r, c);
+  plot(x0 + r, y0, c);
+  plot(x0 - r, y0, c);
+  while (x < y) {
+    if (f >= 0) {
+      y--;
+      ddFy += 2;
+      f += ddFy;
+    }
+    x++;
+    ddFx += 2;
+    f += ddFx;
+    plot(x0 + x, y0 + y, c);
+    plot(x0 - x, y0 + y, c);
+    plot(x0 + x, y0 - y, c);
+    plot(x0 - x, y0 - y, c);
+    plot(x0 + y, y0 + x, c);
+    plot(x0 - y, y0 + x, c);
+    plot(x0 + y, y0 - x, c);
+    plot(x0 - y, y0 - x, c);
+  }
+}
+
+// TFT_eSPI::fillCircle span walk
+void TFT_eSPI::fillCircle(int32_t x0, int32_t y0, int32_t r, uint32_t color) {
+  int32_t x = 0;
+  int32_t dx = 1;
+  int32_t dy = r + r;
+  int32_t p = -(r >> 1);
+  drawFastHLine(x0 - r, y0, dy + 1, color);
+  while (x < r) {
+    if (p >= 0) {
+      drawFastHLine(x0 - x, y0 + r, dx, color);
+      drawFastHLine(x0 - x, y0 - r, dx, color);
+      dy -= 2;
+      p -= dy;
+      r--;
+    }
+    dx += 2;
+    p += dx;
+    x++;
+    drawFastHLine(x0 - r, y0 + x, dy + 1, color);
+    drawFastHLine(x0 - r, y0 - x, dy + 1, color);
+  }
+}
+
+// Adafruit_GFX / TFT_eSPI fillTriangle
+void TFT_eSPI::fillTriangle(int32_t x0, int32_t y0, int32_t x1, int32_t y1, int32_t x2, int32_t y2,
+                            uint32_t color) {
+  int32_t a, b, y, last;
+  if (y0 > y1) {
+    std::swap(y0, y1);
+    std::swap(x0, x1);
+  }
+  if (y1 > y2) {
+    std::swap(y2, y1);
+    std::swap(x2, x1);
+  }
+  if (y0 > y1) {
+    std::swap(y0, y1);
+    std::swap(x0, x1);
+  }
+
+  if (y0 == y2) {
+    a = b = x0;
+    if (x1 < a) a = x1;
+    else if (x1 > b) b = x1;
+    if (x2 < a) a = x2;
+    else if (x2 > b) b = x2;
+    drawFastHLine(a, y0, b - a + 1, color);
+    return;
+  }
+
+  int32_t dx01 = x1 - x0, dy01 = y1 - y0, dx02 = x2 - x0, dy02 = y2 - y0, dx12 = x2 - x1, dy12 = y2 - y1;
+  int32_t sa = 0, sb = 0;
+
+  last = (y1 == y2) ? y1 : y1 - 1;
+  for (y = y0; y <= last; y++) {
+    a = x0 + sa / dy01;
+    b = x0 + sb / dy02;
+    sa += dx01;
+    sb += dx02;
+    if (a > b) std::swap(a, b);
+    drawFastHLine(a, y, b - a + 1, color);
+  }
+
+  sa = dx12 * (y - y1);
+  sb = dx02 * (y - y0);
+  for (; y <= y2; y++) {
+    a = x1 + sa / dy12;
+    b = x0 + sb / dy02;
+    sa += dx12;
+    sb += dx02;
+    if (a > b) std::swap(a, b);
+    drawFastHLine(a, y, b - a + 1, color);
+  }
+}
+
+// Anti-aliased one pixel ring of radius r
+void TFT_eSPI::drawSmoothCircle(int32_t x, int32_t y, int32_t r, uint32_t fg, uint32_t bg) {
+  windows++;
+  for (int32_t j = -r - 1; j <= r + 1; j++) {
+    for (int32_t i = -r - 1; i <= r + 1; i++) {
+      float d = fabsf(sqrtf((float)(i * i + j * j)) - (float)r);
+      plotAlpha(x + i, y + j, 1.0f - d, (uint16_t)fg, bg);
+    }
+  }
+}
+
+void TFT_eSPI::fillSmoothCircle(int32_t x, int32_t y, int32_t r, uint32_t color, uint32_t bg) {
+  windows++;
+  for (int32_t j = -r - 1; j <= r + 1; j++) {
+    for (int32_t i = -r - 1; i <= r + 1; i++) {
+      float d = sqrtf((float)(i * i + j * j));
+      plotAlpha(x + i, y + j, (float)r + 0.5f - d, (uint16_t)color, bg);
+    }
+  }
+}
+
+void TFT_eSPI::drawWideLine(float ax, float ay, float bx, float by, float wd, uint32_t fg, uint32_t bg) {
+  drawWedgeLine(ax, ay, bx, by, wd, wd, fg, bg);
+}
+
+// Round-ended line whose width goes from aw at a to bw at b: coverage from
+// the distance to the tapered capsule
+void TFT_eSPI::drawWedgeLine(float ax, float ay, float bx, float by, float aw, float bw, uint32_t fg,
+                             uint32_t bg) {
+  windows++;
+  float ar = aw / 2.0f;
+  float br = bw / 2.0f;
+  int32_t x0 = (int32_t)floorf(min(ax - ar, bx - br)) - 1;
+  int32_t y0 = (int32_t)floorf(min(ay - ar, by - br)) - 1;
+  int32_t x1 = (int32_t)ceilf(max(ax + ar, bx + br)) + 1;
+  int32_t y1 = (int32_t)ceilf(max(ay + ar, by + br)) + 1;
+  float bax = bx - ax;
+  float bay = by - ay;
+  float len2 = bax * bax + bay * bay;
+  for (int32_t y = y0; y <= y1; y++) {
+    for (int32_t x = x0; x <= x1; x++) {
+      float pax = x - ax;
+      float pay = y - ay;
+      float h = len2 > 0.0f ? (pax * bax + pay * bay) / len2 : 0.0f;
+      h = h < 0.0f ? 0.0f : (h > 1.0f ? 1.0f : h);
+      float dx = pax - bax * h;
+      float dy = pay - bay * h;
+      float d = sqrtf(dx * dx + dy * dy) - (ar + (br - ar) * h);
+      plotAlpha(x, y, 0.5f - d, (uint16_t)fg, bg);
+    }
+  }
+}
+
+void TFT_eSPI::pushImage(int32_t x, int32_t y, int32_t w, int32_t h, const uint16_t *data) {
+  windows++;
+  for (int32_t j = 0; j < h; j++) {
+    for (int32_t i = 0; i < w; i++) {
+      plot(x + i, y + j, data[(size_t)j * w + i]);
+    }
+  }
+}
+
+// =========================
+// Text
+// =========================
+
+void TFT_eSPI::setTextFont(uint8_t f) {
+  textFont_ = f;
+}
+
+void TFT_eSPI::loadFont(const uint8_t *array) {
+  unloadFont();
+  smooth_ = new ShimFont();
+  if (!smooth_->parse(array)) unloadFont();
+}
+
+void TFT_eSPI::loadFont(String name, fs::FS &) {
+  unloadFont();
+  char path[256];
+  snprintf(path, sizeof(path), "%s/%s.vlw", shimDataDir, name.c_str());
+  smooth_ = new ShimFont();
+  if (!readFile(path, &smooth_->file) || !smooth_->parse(smooth_->file.data())) unloadFont();
+}
+
+void TFT_eSPI::unloadFont() {
+  delete smooth_;
+  smooth_ = nullptr;
+}
+
+const ShimFont *TFT_eSPI::activeFont() const {
+  return smooth_ ? smooth_ : standInFont(textFont_);
+}
+
+int16_t TFT_eSPI::fontHeight() {
+  if (smooth_) return (int16_t)smooth_->yAdvance;
+  return standIn(textFont_).lineHeight * textSize_;
+}
+
+// TFT_eSPI smooth font textWidth(): advances, except the last glyph counts
+// its ink (dX + width)
+int16_t TFT_eSPI::textWidth(const char *s) {
+  const ShimFont *font = activeFont();
+  int32_t w = 0;
+  for (const char *p = s; *p; p++) {
+    if ((uint8_t)*p < 0x20) continue;  // Control characters draw nothing
+    int g = font ? font->find((uint8_t)*p) : -1;
+    if (g < 0) {
+      w += font ? font->spaceWidth + 1 : 6;
+    } else if (p[1] != '\0') {
+      w += font->xAdvance[g];
+    } else {
+      w += font->dX[g] + font->width[g];
+    }
+  }
+  return (int16_t)w;
+}
+
+void TFT_eSPI::drawGlyph(uint16_t code, int32_t &cursorX, int32_t cursorY) {
+  const ShimFont *font = activeFont();
+  if (code < 0x20) return;
+  if (font == nullptr) {
+    cursorX += 6;
+    return;
+  }
+  bool fill = fillBg_ && textFg_ != textBg_;
+  // Bitmap stand-ins sit in their line box like the real 8/16/26 px fonts
+  int32_t top = cursorY;
+  if (!smooth_) top += (standIn(textFont_).lineHeight - font->yAdvance) / 2;
+
+  if (code == ' ') {
+    int32_t adv = font->spaceWidth;
+    if (fill) fillRect(cursorX, cursorY, adv, fontHeight(), textBg_);
+    cursorX += adv;
+    return;
+  }
+  int g = font->find(code);
+  if (g < 0) {
+    drawRect(cursorX, top + font->maxAscent - font->ascent, font->spaceWidth, font->ascent, textFg_);
+    cursorX += font->spaceWidth + 1;
+    return;
+  }
+
+  int32_t gx = cursorX + font->dX[g];
+  int32_t gy = top + font->maxAscent - font->dY[g];
+  const uint8_t *bmp = font->data + font->bitmap[g];
+  windows++;
+  for (int32_t y = 0; y < font->height[g]; y++) {
+    for (int32_t x = 0; x < font->width[g]; x++) {
+      uint8_t a = bmp[y * font->width[g] + x];
+      if (a == 0xFF) {
+        plot(gx + x, gy + y, textFg_);
+      } else if (a) {
+        uint16_t under = (textFg_ != textBg_) ? textBg_ : readPixel(gx + x, gy + y);
+        plot(gx + x, gy + y, alphaBlend(a, textFg_, under));
+      } else if (fill) {
+        plot(gx + x, gy + y, textBg_);
+      }
+    }
+  }
+  cursorX += font->xAdvance[g];
+}
+
+int16_t TFT_eSPI::drawString(const char *s, int32_t x, int32_t y) {
+  int32_t w = textWidth(s);
+  int32_t h = fontHeight();
+  int32_t baseline = smooth_ ? smooth_->maxAscent : h * 3 / 4;
+  switch (datum_) {
+    case TC_DATUM: x -= w / 2; break;
+    case TR_DATUM: x -= w; break;
+    case ML_DATUM: y -= h / 2; break;
+    case MC_DATUM: x -= w / 2; y -= h / 2; break;
+    case MR_DATUM: x -= w; y -= h / 2; break;
+    case BL_DATUM: y -= h; break;
+    case BC_DATUM: x -= w / 2; y -= h; break;
+    case BR_DATUM: x -= w; y -= h; break;
+    case L_BASELINE: y -= baseline; break;
+    case C_BASELINE: x -= w / 2; y -= baseline; break;
+    case R_BASELINE: x -= w; y -= baseline; break;
+    default: break;
+  }
+
+  // Padding: clear the part of the padded box the text doesn't cover
+  if (padding_ > w && textFg_ != textBg_) {
+    int32_t px = x;
+    if (datum_ == TC_DATUM || datum_ == MC_DATUM || datum_ == BC_DATUM || datum_ == C_BASELINE) {
+      px = x - (padding_ - w) / 2;
+    } else if (datum_ == TR_DATUM || datum_ == MR_DATUM || datum_ == BR_DATUM || datum_ == R_BASELINE) {
+      px = x - (padding_ - w);
+    }
+    fillRect(px, y, padding_, h, textBg_);
+  }
+
+  int32_t cursor = x;
+  for (const char *p = s; *p; p++) {
+    drawGlyph((uint8_t)*p, cursor, y);
+  }
+  return (int16_t)w;
+}
+
+// =========================
+// TFT_eSprite
+// =========================
+
+TFT_eSprite::TFT_eSprite(TFT_eSPI *parent) : TFT_eSPI(0, 0), parent_(parent) {}
+
+TFT_eSprite::TFT_eSprite(const TFT_eSprite &other) : TFT_eSPI(0, 0), parent_(other.parent_) {
+  depth_ = other.depth_;
+}
+
+TFT_eSprite::~TFT_eSprite() {}
+
+void *TFT_eSprite::createSprite(int16_t w, int16_t h, uint8_t) {
+  if (created_) return getPointer();
+  width_ = w;
+  height_ = h;
+  if (depth_ == 1) {
+    bits_.assign((size_t)((w + 7) / 8) * h, 0);
+  } else {
+    fb_.assign((size_t)w * h, 0);
+  }
+  created_ = true;
+  resetViewport();
+  return getPointer();
+}
+
+void TFT_eSprite::deleteSprite() {
+  fb_.clear();
+  fb_.shrink_to_fit();
+  bits_.clear();
+  bits_.shrink_to_fit();
+  created_ = false;
+  width_ = height_ = 0;
+  resetViewport();
+}
+
+void TFT_eSprite::storePixel(int32_t x, int32_t y, uint16_t color) {
+  if (!created_) return;
+  if (depth_ == 1) {
+    uint8_t &byte = bits_[(size_t)y * ((width_ + 7) / 8) + x / 8];
+    uint8_t mask = 0x80 >> (x & 7);
+    byte = color ? (byte | mask) : (byte & ~mask);
+  } else {
+    fb_[(size_t)y * width_ + x] = color;
+  }
+}
+
+void TFT_eSprite::storeRun(int32_t x, int32_t y, int32_t n, uint16_t color) {
+  if (depth_ != 16) {
+    for (int32_t i = 0; i < n; i++) storePixel(x + i, y, color);
+    return;
+  }
+  if (created_) std::fill_n(fb_.begin() + (size_t)y * width_ + x, n, color);
+}
+
+void TFT_eSprite::storeRun(int32_t x, int32_t y, int32_t n, const uint16_t *src) {
+  if (depth_ != 16) {
+    for (int32_t i = 0; i < n; i++) storePixel(x + i, y, src[i]);
+    return;
+  }
+  if (created_) std::copy_n(src, n, fb_.begin() + (size_t)y * width_ + x);
+}
+
+uint16_t TFT_eSprite::loadPixel(int32_t x, int32_t y) {
+  if (!created_) return 0;
+  if (depth_ == 1) {
+    uint8_t byte = bits_[(size_t)y * ((width_ + 7) / 8) + x / 8];
+    return (byte & (0x80 >> (x & 7))) ? bitmapFg_ : bitmapBg_;
+  }
+  return fb_[(size_t)y * width_ + x];
+}
+
+void TFT_eSprite::pushSprite(int32_t x, int32_t y) {
+  pushSprite(x, y, 0, 0, width_, height_);
+}
+
+void TFT_eSprite::pushSprite(int32_t x, int32_t y, uint16_t transparent) {
+  if (!created_) return;
+  parent_->windows++;
+  for (int32_t j = 0; j < height_; j++) {
+    for (int32_t i = 0; i < width_; i++) {
+      uint16_t c = loadPixel(i, j);
+      if (c != transparent) parent_->plot(x + i, y + j, c);
+    }
+  }
+}
+
+bool TFT_eSprite::pushSprite(int32_t tx, int32_t ty, int32_t sx, int32_t sy, int32_t sw, int32_t sh) {
+  if (!created_) return false;
+  parent_->windows++;
+  // Source rectangle within the sprite, destination within the parent's clip
+  TFT_eSPI &dst = *parent_;
+  if (dst.vpDatum_) {
+    tx += dst.vpX_;
+    ty += dst.vpY_;
+  }
+  int32_t i0 = max(max(0, -sx), dst.clipX0_ - tx);
+  int32_t i1 = min(min(sw, width_ - sx), dst.clipX1_ - tx);
+  int32_t j0 = max(max(0, -sy), dst.clipY0_ - ty);
+  int32_t j1 = min(min(sh, height_ - sy), dst.clipY1_ - ty);
+  static std::vector<uint16_t> row;  // 1-bit rows expanded (kept: no per-push allocation)
+  row.resize(max(i1 - i0, 0));
+  for (int32_t j = j0; j < j1 && i0 < i1; j++) {
+    if (depth_ == 16) {
+      dst.storeRun(tx + i0, ty + j, i1 - i0, &fb_[(size_t)(sy + j) * width_ + sx + i0]);
+    } else {
+      for (int32_t i = i0; i < i1; i++) row[i - i0] = loadPixel(sx + i, sy + j);
+      dst.storeRun(tx + i0, ty + j, i1 - i0, row.data());
+    }
+  }
+  return true;
+}
@@ -0,0 +1,400 @@
+// tzbench: host-side benchmark + differential checker for the timezone engine.
+//
+// Build & run (PlatformIO native env, Linux/macOS):
+//   pio run -e native && .pio/build/native/program            # benchmark
+//   .pio/build/native/program --verify                        # diff vs libc
+//
+// Benchmark: times getLocalTimeNoSetenv()/isDstActive() for every timezones[]
+// entry, 1970-2100, and compares against the legacy per-call path (gmtime_r +
+// transition-day search on every call, as used before the per-year cache).
+// Also times one updateAllCityTimes() refresh (6 cities) before/after the
+// integer civil-time batch path.
+//
+// Verify: compares every conversion with setenv("TZ") + localtime_r(), on a
+// coarse sweep plus one second either side of every DST transition.
+// Exits non-zero on any mismatch so it can gate CI.
+//
+// Verify tzdb: `--tzdb file.bin` (from tools/tzdb/mktzdb.py) checks every zone
+// in the database against localtime_r() with TZ=":Area/City", 1970-2100, on
+// the same sweep plus one second either side of every stored transition.
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "timezones.h"
+#include "tz_db.h"
+#include "tz_engine.h"
+
+static const time_t kSweepStart = 0;            // 1970-01-01 00:00 UTC
+static const time_t kSweepEnd = 4102444800LL;   // 2100-01-01 00:00 UTC
+static const time_t kSweepStep = 86400 + 3671;  // ~1 day, drifts through all hours
+static const time_t kSteadyStart = 1775606400LL; // 2026-04-08 00:00 UTC
+static const int kSteadyCalls = 200000;          // consecutive seconds, like the clock loop
+
+// =========================
+// Legacy reference (pre-cache engine, kept verbatim for before/after numbers)
+// =========================
+namespace legacy {
+
+static int dayOfWeek(int year, int month, int day) {
+  if (month < 3) {
+    month += 12;
+    year--;
+  }
+  int k = year % 100;
+  int j = year / 100;
+  int dow = (day + (13 * (month + 1)) / 5 + k + k / 4 + j / 4 - 2 * j) % 7;
+  return (dow + 6) % 7;
+}
+
+static int getDstTransitionDay(int year, const DstRule* rule) {
+  int month = rule->month;
+  if (rule->week == 5) {
+    int daysInMonth[] = {0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    if (month == 2 && ((year % 4 == 0 && year % 100 != 0) || year % 400 == 0)) {
+      daysInMonth[2] = 29;
+    }
+    int lastDay = daysInMonth[month];
+    int diff = dayOfWeek(year, month, lastDay) - rule->dow;
+    if (diff < 0) diff += 7;
+    return lastDay - diff;
+  }
+  int diff = rule->dow - dayOfWeek(year, month, 1);
+  if (diff < 0) diff += 7;
+  return 1 + diff + (rule->week - 1) * 7;
+}
+
+static bool isDstActive(time_t utc, const ParsedTimezone* tz) {
+  if (!tz->hasDst) return false;
+  time_t approxLocal = utc + (tz->stdOffsetMins * 60);
+  struct tm ltm;
+  gmtime_r(&approxLocal, &ltm);
+  int year = ltm.tm_year + 1900;
+  int current = (ltm.tm_mon + 1) * 10000 + ltm.tm_mday * 100 + ltm.tm_hour;
+  int start = tz->dstStart.month * 10000 + getDstTransitionDay(year, &tz->dstStart) * 100 + tz->dstStart.hour;
+  int end = tz->dstEnd.month * 10000 + getDstTransitionDay(year, &tz->dstEnd) * 100 + tz->dstEnd.hour;
+  if (tz->dstStart.month > tz->dstEnd.month) {
+    return (current >= start || current < end);
+  }
+  return (current >= start && current < end);
+}
+
+static void getLocalTime(time_t utc, const ParsedTimezone* tz, struct tm* out) {
+  int16_t offsetMins = isDstActive(utc, tz) ? tz->dstOffsetMins : tz->stdOffsetMins;
+  time_t local = utc + (offsetMins * 60);
+  gmtime_r(&local, out);
+}
+
+// updateAllCityTimes() as it was before the integer batch path:
+// one gmtime_r per city plus snprintf and tm_year/tm_yday comparisons.
+struct CachedTimeInfo {
+  struct tm tm;
+  char timeStr[8];
+  bool prevDay;
+  bool nextDay;
+};
+
+static void updateAllCityTimes(time_t now, ParsedTimezone* tzs, CachedTimeInfo* cache) {
+  for (int i = 0; i < 6; i++) {
+    int16_t offsetMins = ::isDstActive(now, &tzs[i]) ? tzs[i].dstOffsetMins : tzs[i].stdOffsetMins;
+    time_t local = now + (offsetMins * 60);
+    gmtime_r(&local, &cache[i].tm);
+    snprintf(cache[i].timeStr, sizeof(cache[i].timeStr), "%02d:%02d",
+             cache[i].tm.tm_hour, cache[i].tm.tm_min);
+    cache[i].prevDay = (cache[i].tm.tm_year < cache[0].tm.tm_year) ||
+                       (cache[i].tm.tm_year == cache[0].tm.tm_year && cache[i].tm.tm_yday < cache[0].tm.tm_yday);
+    cache[i].nextDay = (cache[i].tm.tm_year > cache[0].tm.tm_year) ||
+                       (cache[i].tm.tm_year == cache[0].tm.tm_year && cache[i].tm.tm_yday > cache[0].tm.tm_yday);
+  }
+}
+
+}  // namespace legacy
+
+// Mirror of main.cpp updateAllCityTimes() (batched integer conversion)
+struct CachedTimeInfo {
+  LocalTime lt;
+  char timeStr[8];
+  bool prevDay;
+  bool nextDay;
+};
+
+static void updateAllCityTimes(time_t now, ParsedTimezone* tzs, CachedTimeInfo* cache) {
+  LocalTime local[6];
+  utcToLocalBatch(now, tzs, local, 6);
+  for (int i = 0; i < 6; i++) {
+    cache[i].lt = local[i];
+    formatTimeHHMM(&local[i], cache[i].timeStr);
+    int dayDiff = compareLocalDate(&local[i], &local[0]);
+    cache[i].prevDay = (dayDiff < 0);
+    cache[i].nextDay = (dayDiff > 0);
+  }
+}
+
+// Firmware default cities (home + 5 remote)
+static const char* const kDefaultCityTzs[6] = {
+  "AEST-10AEDT,M10.1.0/2,M4.1.0/3",
+  "PST8PDT,M3.2.0/2,M11.1.0/2",
+  "GMT0BST,M3.5.0/1,M10.5.0/2",
+  "EAT-3",
+  "MST7MDT,M3.2.0/2,M11.1.0/2",
+  "JST-9"
+};
+
+// =========================
+// Benchmark
+// =========================
+typedef std::chrono::steady_clock Clock;
+
+static double elapsedNs(Clock::time_point start) {
+  return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+struct BenchResult {
+  double ns;
+  long calls;
+  long checksum;  // Keeps the optimiser from discarding the work
+};
+
+template <typename Fn>
+static BenchResult runSweep(Fn fn, time_t start, time_t end, time_t step) {
+  BenchResult r = {0, 0, 0};
+  ParsedTimezone tz;
+  for (int i = 0; i < numTimezones; i++) {
+    parseTimezoneString(timezones[i].tzString, &tz);
+    Clock::time_point t0 = Clock::now();
+    for (time_t t = start; t < end; t += step) {
+      r.checksum += fn(t, &tz);
+      r.calls++;
+    }
+    r.ns += elapsedNs(t0);
+  }
+  return r;
+}
+
+static void printRow(const char* name, const BenchResult& r) {
+  printf("  %-34s %8.1f ns/call  %7.2f M conv/s  (%ld calls, chk %ld)\n",
+         name, r.ns / r.calls, r.calls / r.ns * 1000.0, r.calls, r.checksum);
+}
+
+static void runBenchmark() {
+  printf("tzbench: %d timezones\n", numTimezones);
+
+  auto legacyDst = [](time_t t, ParsedTimezone* tz) -> long { return legacy::isDstActive(t, tz); };
+  auto cachedDst = [](time_t t, ParsedTimezone* tz) -> long { return isDstActive(t, tz); };
+  auto legacyConv = [](time_t t, ParsedTimezone* tz) -> long {
+    struct tm tm;
+    legacy::getLocalTime(t, tz, &tm);
+    return tm.tm_hour + tm.tm_min;
+  };
+  auto cachedConv = [](time_t t, ParsedTimezone* tz) -> long {
+    struct tm tm;
+    getLocalTimeNoSetenv(t, tz, &tm);
+    return tm.tm_hour + tm.tm_min;
+  };
+
+  time_t steadyEnd = kSteadyStart + kSteadyCalls;
+  printf("\nSteady state (%d consecutive seconds per zone):\n", kSteadyCalls);
+  printRow("isDstActive (legacy)", runSweep(legacyDst, kSteadyStart, steadyEnd, 1));
+  printRow("isDstActive (cached)", runSweep(cachedDst, kSteadyStart, steadyEnd, 1));
+  printRow("getLocalTimeNoSetenv (legacy)", runSweep(legacyConv, kSteadyStart, steadyEnd, 1));
+  printRow("getLocalTimeNoSetenv (cached)", runSweep(cachedConv, kSteadyStart, steadyEnd, 1));
+
+  // One refresh per minute for a year, default 6 cities
+  const int refreshes = 365 * 24 * 60;
+  ParsedTimezone cities[6];
+  for (int i = 0; i < 6; i++) parseTimezoneString(kDefaultCityTzs[i], &cities[i]);
+  long chk = 0;
+
+  legacy::CachedTimeInfo legacyCache[6];
+  Clock::time_point t0 = Clock::now();
+  for (int r = 0; r < refreshes; r++) {
+    legacy::updateAllCityTimes(kSteadyStart + r * 60, cities, legacyCache);
+    chk += legacyCache[5].timeStr[4] + legacyCache[3].prevDay;
+  }
+  double legacyNs = elapsedNs(t0);
+
+  CachedTimeInfo cache[6];
+  t0 = Clock::now();
+  for (int r = 0; r < refreshes; r++) {
+    updateAllCityTimes(kSteadyStart + r * 60, cities, cache);
+    chk += cache[5].timeStr[4] + cache[3].prevDay;
+  }
+  double batchNs = elapsedNs(t0);
+
+  printf("\nupdateAllCityTimes() per refresh (6 cities, %d refreshes, chk %ld):\n", refreshes, chk);
+  printf("  %-34s %8.1f ns/refresh\n", "gmtime_r + snprintf (before)", legacyNs / refreshes);
+  printf("  %-34s %8.1f ns/refresh\n", "integer batch (after)", batchNs / refreshes);
+
+  printf("\nSweep 1970-2100 (step %lds, year cache rebuilt every year):\n", (long)kSweepStep);
+  printRow("isDstActive (legacy)", runSweep(legacyDst, kSweepStart, kSweepEnd, kSweepStep));
+  printRow("isDstActive (cached)", runSweep(cachedDst, kSweepStart, kSweepEnd, kSweepStep));
+  printRow("getLocalTimeNoSetenv (legacy)", runSweep(legacyConv, kSweepStart, kSweepEnd, kSweepStep));
+  printRow("getLocalTimeNoSetenv (cached)", runSweep(cachedConv, kSweepStart, kSweepEnd, kSweepStep));
+}
+
+// =========================
+// Differential check against libc
+// =========================
+static int reportLimit = 10;
+
+static bool checkInstant(const char* name, const char* tzString, time_t t, ParsedTimezone* tz) {
+  struct tm ours;
+  struct tm ref;
+  getLocalTimeNoSetenv(t, tz, &ours);
+  localtime_r(&t, &ref);
+  if (ours.tm_year == ref.tm_year && ours.tm_yday == ref.tm_yday &&
+      ours.tm_mon == ref.tm_mon && ours.tm_mday == ref.tm_mday &&
+      ours.tm_wday == ref.tm_wday && ours.tm_hour == ref.tm_hour &&
+      ours.tm_min == ref.tm_min && ours.tm_sec == ref.tm_sec) {
+    return true;
+  }
+  if (reportLimit > 0) {
+    reportLimit--;
+    printf("  MISMATCH %-28s t=%lld  ours=%04d-%02d-%02d %02d:%02d  libc=%04d-%02d-%02d %02d:%02d (%s)\n",
+           name, (long long)t,
+           ours.tm_year + 1900, ours.tm_mon + 1, ours.tm_mday, ours.tm_hour, ours.tm_min,
+           ref.tm_year + 1900, ref.tm_mon + 1, ref.tm_mday, ref.tm_hour, ref.tm_min,
+           tzString);
+  }
+  return false;
+}
+
+static int runVerify() {
+  // Coarse sweep: ~3h17m steps walk through every hour and many minute offsets
+  const time_t step = 3 * 3600 + 17 * 60;
+  long checked = 0;
+  long failed = 0;
+  int failedZones = 0;
+
+  for (int i = 0; i < numTimezones; i++) {
+    setenv("TZ", timezones[i].tzString, 1);
+    tzset();
+
+    ParsedTimezone tz;
+    parseTimezoneString(timezones[i].tzString, &tz);
+    long zoneFailed = 0;
+
+    for (time_t t = kSweepStart; t < kSweepEnd; t += step) {
+      checked++;
+      if (!checkInstant(timezones[i].name, timezones[i].tzString, t, &tz)) zoneFailed++;
+    }
+
+    // Edges: one second either side of each cached transition, every year
+    if (tz.hasDst) {
+      for (time_t t = kSweepStart; t < kSweepEnd; t = tz.yearEndUtc) {
+        isDstActive(t, &tz);  // Rebuild cache for this year
+        time_t edges[] = {tz.dstStartUtc, tz.dstEndUtc};
+        for (time_t e : edges) {
+          if (e <= kSweepStart) continue;  // glibc only applies rules from 1970
+          for (time_t d = -1; d <= 1; d++) {
+            checked++;
+            if (!checkInstant(timezones[i].name, timezones[i].tzString, e + d, &tz)) zoneFailed++;
+          }
+        }
+        isDstActive(t, &tz);  // checkInstant may have moved the cache
+      }
+    }
+
+    if (zoneFailed) {
+      failedZones++;
+      failed += zoneFailed;
+    }
+  }
+
+  printf("tzbench --verify: %ld instants over %d zones, %ld mismatches in %d zones\n",
+         checked, numTimezones, failed, failedZones);
+  return failed ? 1 : 0;
+}
+
+// libc offset is not a whole minute (e.g. Monrovia -0:44:30 until 1972):
+// the database stores minutes, like LocalTime::offsetMins, so skip these
+static bool subMinuteOffset(time_t t) {
+  struct tm ref;
+  localtime_r(&t, &ref);
+  return ref.tm_gmtoff % 60 != 0;
+}
+
+static int runVerifyTzdb(const char* path) {
+  if (!tzdbOpen(path)) {
+    printf("tzbench --tzdb: cannot open %s (or bad header)\n", path);
+    return 1;
+  }
+
+  const time_t step = 3 * 3600 + 17 * 60;
+  long checked = 0;
+  long failed = 0;
+  long skipped = 0;
+  int failedZones = 0;
+  uint32_t readsBefore = tzdbFileReads();
+
+  for (uint16_t i = 0; i < tzdbZoneCount(); i++) {
+    char name[TZDB_NAME_LEN];
+    char tzEnv[TZDB_NAME_LEN + 1];
+    tzdbZoneName(i, name, sizeof(name));
+    snprintf(tzEnv, sizeof(tzEnv), ":%s", name);
+    setenv("TZ", tzEnv, 1);
+    tzset();
+
+    TzDbZone zone;
+    if (!tzdbFindZone(name, &zone)) {
+      printf("  MISSING %s (index lookup failed)\n", name);
+      failedZones++;
+      continue;
+    }
+    ParsedTimezone tz{};
+    tz.db = &zone;
+    long zoneFailed = 0;
+
+    // Sweep walks forward, so each segment is loaded once (like the clock)
+    for (time_t t = kSweepStart; t < kSweepEnd; t += step) {
+      if (subMinuteOffset(t)) {
+        skipped++;
+        continue;
+      }
+      checked++;
+      if (!checkInstant(name, tzEnv, t, &tz)) zoneFailed++;
+    }
+
+    // Edges: one second either side of every stored transition
+    time_t prevEnd = 0;
+    for (time_t t = kSweepStart; t < kSweepEnd && !zone.segUsesFooter; t = zone.segEndUtc) {
+      tzdbOffsetAt(t, &zone, nullptr);
+      if (zone.segEndUtc == prevEnd) break;
+      prevEnd = zone.segEndUtc;
+      if (zone.segStartUtc > kSweepStart) {
+        for (time_t d = -1; d <= 1; d++) {
+          if (subMinuteOffset(zone.segStartUtc + d)) {
+            skipped++;
+            continue;
+          }
+          checked++;
+          if (!checkInstant(name, tzEnv, zone.segStartUtc + d, &tz)) zoneFailed++;
+        }
+      }
+    }
+
+    if (zoneFailed) {
+      failedZones++;
+      failed += zoneFailed;
+    }
+  }
+
+  printf("tzbench --tzdb: %ld instants over %u zones, %ld mismatches in %d zones "
+         "(%ld sub-minute skipped), %u file reads\n",
+         checked, tzdbZoneCount(), failed, failedZones, skipped,
+         (unsigned)(tzdbFileReads() - readsBefore));
+  return (failed || failedZones) ? 1 : 0;
+}
+
+int main(int argc, char** argv) {
+  if (argc > 1 && strcmp(argv[1], "--verify") == 0) {
+    return runVerify();
+  }
+  if (argc > 2 && strcmp(argv[1], "--tzdb") == 0) {
+    return runVerifyTzdb(argv[2]);
+  }
+  runBenchmark();
+  return 0;
+}
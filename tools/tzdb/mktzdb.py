@@ -0,0 +1,188 @@
+#!/usr/bin/env python3
+"""mktzdb.py - pack the system zoneinfo (TZif) files into data/tzdb.bin.
+
+The firmware reads this file from LittleFS (see include/tz_db.h) when a city's
+timezone string is ":Area/City". Each zone stores its UTC offset transitions
+sorted by time, so the device can binary-search the few records around "now"
+straight from flash instead of loading the database into RAM.
+
+Usage:
+    python3 tools/tzdb/mktzdb.py                       # all zones -> data/tzdb.bin
+    python3 tools/tzdb/mktzdb.py --zones Europe/London Asia/Tokyo
+    python3 tools/tzdb/mktzdb.py --zoneinfo /path/to/zoneinfo -o /tmp/tzdb.bin
+    pio run -t uploadfs                                # flash it with the web UI files
+
+File layout (little endian), must match include/tz_db.h:
+    header  16 bytes: "CYTZ", u8 version, u8 record size, u16 zone count,
+                      u32 index offset, u32 file size
+    index   48 bytes per zone, sorted by name (binary searchable):
+                      char name[36], u32 transitions offset, u32 footer offset,
+                      u16 transition count, i16 offset (mins) before the first
+                      transition
+    records  8 bytes per transition, sorted by time:
+                      u32 UTC seconds since 1970, i16 offset (mins), u8 isDst, u8 0
+    footers  NUL-terminated POSIX TZ strings (rule used after the last record)
+
+Zones that are links (or identical copies) share one transition block.
+Transitions before 1970 are dropped: the clock never shows earlier times.
+"""
+
+import argparse
+import os
+import struct
+import sys
+
+MAGIC = b"CYTZ"
+VERSION = 1
+HEADER = struct.Struct("<4sBBHII")
+INDEX_ENTRY = struct.Struct("<36sIIHh")
+RECORD = struct.Struct("<IhBB")
+NAME_LEN = 36
+UINT32_MAX = 0xFFFFFFFF
+
+# Non-geographic / legacy trees that only duplicate the real zones
+SKIP_DIRS = {"posix", "right", "Etc", "SystemV", "US", "Canada", "Mexico",
+             "Brazil", "Chile"}
+
+
+def read_tzif(path):
+    """Return (transitions, types, footer) from a TZif file (v2+ body preferred)."""
+    with open(path, "rb") as f:
+        data = f.read()
+    if data[:4] != b"TZif":
+        return None
+
+    def parse_block(offset, time_size):
+        counts = struct.unpack(">6l", data[offset + 20:offset + 44])
+        isutcnt, isstdcnt, leapcnt, timecnt, typecnt, charcnt = counts
+        p = offset + 44
+        fmt = ">%d%s" % (timecnt, "q" if time_size == 8 else "l")
+        times = struct.unpack(fmt, data[p:p + timecnt * time_size])
+        p += timecnt * time_size
+        idxs = data[p:p + timecnt]
+        p += timecnt
+        types = []
+        for _ in range(typecnt):
+            utoff, isdst, _abbr = struct.unpack(">lBB", data[p:p + 6])
+            types.append((utoff, isdst))
+            p += 6
+        p += charcnt + leapcnt * (time_size + 4) + isstdcnt + isutcnt
+        return list(zip(times, idxs)), types, p
+
+    version = data[4]
+    transitions, types, end = parse_block(0, 4)
+    footer = ""
+    if version >= ord("2"):
+        transitions, types, end = parse_block(end, 8)
+        nl = data.find(b"\n", end + 1)
+        if data[end:end + 1] == b"\n" and nl > end:
+            footer = data[end + 1:nl].decode("ascii")
+    return transitions, types, footer
+
+
+def build_zone(transitions, types):
+    """Clamp to the u32 time domain and drop records that change nothing."""
+    # Offset in force before the first transition is type 0 (RFC 8536 3.2)
+    initial = types[0] if types else (0, 0)
+    current = (round(initial[0] / 60), initial[1])
+    records = []
+    for when, idx in transitions:
+        utoff, isdst = types[idx]
+        state = (round(utoff / 60), isdst)
+        if when < 0:
+            current = state  # Still before 1970: becomes the initial offset
+            continue
+        if when > UINT32_MAX:
+            break
+        prev = records[-1][1] if records else current
+        if state != prev:
+            records.append((when, state))
+    return current[0], records
+
+
+def collect_zones(root, wanted):
+    zones = {}
+    if wanted:
+        names = wanted
+    else:
+        names = []
+        for dirpath, dirnames, filenames in os.walk(root):
+            rel = os.path.relpath(dirpath, root)
+            top = rel.split(os.sep)[0]
+            if top in SKIP_DIRS:
+                dirnames[:] = []
+                continue
+            for fn in filenames:
+                name = fn if rel == "." else os.path.join(rel, fn).replace(os.sep, "/")
+                if "/" not in name:
+                    continue  # Top-level aliases (GB, Japan, EST5EDT, ...)
+                names.append(name)
+    for name in sorted(set(names)):
+        if len(name) >= NAME_LEN:
+            print("skipping %s: name longer than %d chars" % (name, NAME_LEN - 1),
+                  file=sys.stderr)
+            continue
+        parsed = read_tzif(os.path.join(root, name))
+        if parsed is None:
+            continue
+        transitions, types, footer = parsed
+        initial, records = build_zone(transitions, types)
+        zones[name] = (initial, records, footer)
+    return zones
+
+
+def pack(zones):
+    names = sorted(zones)
+    index_off = HEADER.size
+    data_off = index_off + INDEX_ENTRY.size * len(names)
+
+    blocks = bytearray()
+    block_offsets = {}  # (records, footer) -> (trans offset, footer offset)
+    entries = bytearray()
+    for name in names:
+        initial, records, footer = zones[name]
+        key = (tuple(records), footer)
+        if key not in block_offsets:
+            trans_off = data_off + len(blocks)
+            for when, (mins, isdst) in records:
+                blocks += RECORD.pack(when, mins, 1 if isdst else 0, 0)
+            footer_off = data_off + len(blocks)
+            blocks += footer.encode("ascii") + b"\0"
+            block_offsets[key] = (trans_off, footer_off)
+        trans_off, footer_off = block_offsets[key]
+        entries += INDEX_ENTRY.pack(name.encode("ascii"), trans_off, footer_off,
+                                    len(records), initial)
+
+    size = data_off + len(blocks)
+    header = HEADER.pack(MAGIC, VERSION, RECORD.size, len(names), index_off, size)
+    return header + bytes(entries) + bytes(blocks), len(block_offsets)
+
+
+def main():
+    here = os.path.dirname(os.path.abspath(__file__))
+    default_out = os.path.normpath(os.path.join(here, "..", "..", "data", "tzdb.bin"))
+
+    ap = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    ap.add_argument("--zoneinfo", default="/usr/share/zoneinfo",
+                    help="compiled TZif tree (default: %(default)s)")
+    ap.add_argument("-o", "--output", default=default_out,
+                    help="output file (default: data/tzdb.bin)")
+    ap.add_argument("--zones", nargs="*", help="only these IANA names")
+    args = ap.parse_args()
+
+    zones = collect_zones(args.zoneinfo, args.zones)
+    if not zones:
+        sys.exit("no TZif files found under " + args.zoneinfo)
+    if len(zones) > 0xFFFF:
+        sys.exit("too many zones")
+
+    blob, unique = pack(zones)
+    with open(args.output, "wb") as f:
+        f.write(blob)
+    records = sum(len(z[1]) for z in zones.values())
+    print("%s: %d zones (%d unique), %d transitions, %d bytes" %
+          (args.output, len(zones), unique, records, len(blob)))
+
+
+if __name__ == "__main__":
+    main()